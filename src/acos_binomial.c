@@ -52,3 +52,93 @@ float acos_binomial(float x, int rounds)
   }
   return M_PI_2 - a;
 }
+
+/// Series coefficients (2k)! / (4^k (k!)^2 (2k + 1)) of arcsin(z) / z in powers of z^2.
+static const float acos_binomial_coeffs[16] = {
+  1.000000000e+00f, 1.666666667e-01f, 7.500000000e-02f, 4.464285714e-02f,
+  3.038194444e-02f, 2.237215909e-02f, 1.735276442e-02f, 1.396484375e-02f,
+  1.155180090e-02f, 9.761609529e-03f, 8.390335810e-03f, 7.312525874e-03f,
+  6.447210312e-03f, 5.740037671e-03f, 5.153309682e-03f, 4.660143487e-03f,
+};
+
+_Static_assert(ACOS_BINOMIAL_TERMS >= 1 && ACOS_BINOMIAL_TERMS <= 16,
+               "ACOS_BINOMIAL_TERMS must be in [1, 16]");
+
+// GCC vector of the widest lanes this tier has, as in acos_minimax.c.
+#if defined(__AVX512F__)
+#define ACOS_BINOMIAL_VBYTES 64
+#elif defined(__AVX__)
+#define ACOS_BINOMIAL_VBYTES 32
+#else
+#define ACOS_BINOMIAL_VBYTES 16
+#endif
+#define ACOS_BINOMIAL_VLANES (ACOS_BINOMIAL_VBYTES / (int)sizeof(float))
+typedef float acos_binomial_vf __attribute__((vector_size(ACOS_BINOMIAL_VBYTES)));
+typedef int acos_binomial_vi __attribute__((vector_size(ACOS_BINOMIAL_VBYTES)));
+
+/// Branch-free select: b where mask is set, a elsewhere (SSE2, so every ISA tier has it).
+static inline __m128 acos_binomial_select(__m128 mask, __m128 a, __m128 b)
+{
+  return _mm_or_ps(_mm_and_ps(mask, b), _mm_andnot_ps(mask, a));
+}
+
+float acos_binomial_rr(float x)
+{
+  __m128 vx = _mm_set_ss(x);
+  __m128 ax = _mm_andnot_ps(_mm_set_ss(-0.0f), vx);
+  // The reduction and sign fold are mask selects rather than ternaries, which GCC
+  // otherwise turns back into branches on unpredictable input; the sqrt is always computed.
+  __m128 reduce = _mm_cmpgt_ss(ax, _mm_set_ss(0.5f));
+  __m128 neg = _mm_cmplt_ss(vx, _mm_setzero_ps());
+  __m128 root = _mm_sqrt_ss(_mm_mul_ss(_mm_sub_ss(_mm_set_ss(1.0f), ax), _mm_set_ss(0.5f)));
+  float z = _mm_cvtss_f32(acos_binomial_select(reduce, ax, root));
+  float z2 = z * z;
+  // Trip count is a compile-time constant, so the loop is fully unrolled.
+  float p = acos_binomial_coeffs[ACOS_BINOMIAL_TERMS - 1];
+  for (int k = ACOS_BINOMIAL_TERMS - 2; k >= 0; k--) p = p * z2 + acos_binomial_coeffs[k];
+  float s = z * p;
+  __m128 ret = acos_binomial_select(reduce, _mm_set_ss((float)M_PI_2 - s), _mm_set_ss(2.0f * s));
+  ret = acos_binomial_select(neg, ret, _mm_sub_ss(_mm_set_ss((float)M_PI), ret));
+  return _mm_cvtss_f32(ret);
+}
+
+static inline acos_binomial_vf acos_binomial_sqrt_v(acos_binomial_vf v)
+{
+#if defined(__AVX512F__)
+  return (acos_binomial_vf)_mm512_sqrt_ps((__m512)v);
+#elif defined(__AVX__)
+  return (acos_binomial_vf)_mm256_sqrt_ps((__m256)v);
+#else
+  return (acos_binomial_vf)_mm_sqrt_ps((__m128)v);
+#endif
+}
+
+/// b where mask is set, a elsewhere; vector compares give all-ones or zero lanes.
+static inline acos_binomial_vf acos_binomial_select_v(acos_binomial_vi mask, acos_binomial_vf a,
+                                                      acos_binomial_vf b)
+{
+  return (acos_binomial_vf)((mask & (acos_binomial_vi)b) | (~mask & (acos_binomial_vi)a));
+}
+
+// Lane for lane the same operations as acos_binomial_rr, so results match it exactly.
+void acos_binomial_rr_v(float *out, const float *in, size_t n)
+{
+  const acos_binomial_vi sign = (acos_binomial_vi){ 0 } + (int)0x80000000;
+  size_t i = 0;
+  for (; i + ACOS_BINOMIAL_VLANES <= n; i += ACOS_BINOMIAL_VLANES) {
+    acos_binomial_vf x, ax, z, z2, p, s, ret;
+    memcpy(&x, in + i, sizeof(x));
+    ax = (acos_binomial_vf)((acos_binomial_vi)x & ~sign);
+    acos_binomial_vi reduce = ax > 0.5f;
+    acos_binomial_vi neg = x < 0.0f;
+    z = acos_binomial_select_v(reduce, ax, acos_binomial_sqrt_v((1.0f - ax) * 0.5f));
+    z2 = z * z;
+    p = (acos_binomial_vf){ 0 } + acos_binomial_coeffs[ACOS_BINOMIAL_TERMS - 1];
+    for (int k = ACOS_BINOMIAL_TERMS - 2; k >= 0; k--) p = p * z2 + acos_binomial_coeffs[k];
+    s = z * p;
+    ret = acos_binomial_select_v(reduce, (float)M_PI_2 - s, 2.0f * s);
+    ret = acos_binomial_select_v(neg, ret, (float)M_PI - ret);
+    memcpy(out + i, &ret, sizeof(ret));
+  }
+  for (; i < n; i++) out[i] = acos_binomial_rr(in[i]);
+}
@@ -2,7 +2,9 @@
 #define __ACOS_BINOMIAL_H
 
 #include <stdlib.h>
+#include <string.h>
 #include <math.h>
+#include <immintrin.h>
 
 /// Source: https://en.wikipedia.org/wiki/Inverse_trigonometric_functions#Infinite_series
 ///
@@ -19,4 +21,29 @@
 /// `rounds` is clamped to [0, 30) since higher values yield NaN due to single-precision limits.
 float acos_binomial(float x, int rounds);
 
+/// Number of series terms acos_binomial_rr evaluates, including the leading `x` term.
+/// Fixed at compile time in [1, 16], e.g. -DACOS_BINOMIAL_TERMS=8.
+#ifndef ACOS_BINOMIAL_TERMS
+#define ACOS_BINOMIAL_TERMS 10
+#endif
+
+/// Range-reduced form of acos_binomial for production use.
+///
+/// The series is only evaluated on |z| <= 0.5, where it converges quickly. Larger |x| are
+/// reduced with the half-angle identity
+///
+///     arcsin(x) = π/2 - 2 * arcsin(sqrt((1 - x) / 2))
+///
+/// so acos(|x|) = 2 * arcsin(sqrt((1 - |x|) / 2)) for |x| > 0.5, and negative inputs are
+/// folded with acos(-x) = π - acos(x). The coefficients (2k)! / (4^k (k!)^2 (2k + 1)) are
+/// precomputed floats and evaluated by Horner's rule in z^2, so there is no integer
+/// arithmetic and no division. With the default 10 terms the truncation error is below
+/// float rounding.
+float acos_binomial_rr(float x);
+
+/// Batch form: out[i] = acos_binomial_rr(in[i]) for i in [0, n), bitwise identical to the
+/// scalar kernel. Evaluates the widest vectors of the tier, with the scalar kernel for
+/// the tail. `out` and `in` may be the same buffer but must not otherwise overlap.
+void acos_binomial_rr_v(float *out, const float *in, size_t n);
+
 #endif
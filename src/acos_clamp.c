@@ -0,0 +1,182 @@
+#include <string.h>
+#include "acos_clamp.h"
+
+#define ACOS_CLAMP_BLOCK ((size_t)1 << 32)
+
+// min(1, |x|) with 1 first: minss/minps return the second operand when either is NaN,
+// so NaN passes through to the result instead of being clamped to 1.
+float acos_nvidia6_clamp(float x)
+{
+  float ax = _mm_cvtss_f32(_mm_min_ss(_mm_set_ss(1.0f), _mm_set_ss(fabsf(x))));
+  return acos_nvidia_ss_ax(x, ax);
+}
+
+#if defined(__AVX512F__)
+
+static inline __attribute__((always_inline))
+__m512 acos_clamp_ps512(__m512 x, const int count, size_t *clamped, size_t *nan)
+{
+  __m512 ax = _mm512_abs_ps(x);
+  if (count) {
+    *clamped += (size_t)__builtin_popcount(_mm512_cmp_ps_mask(ax, _mm512_set1_ps(1.0f), _CMP_GT_OQ));
+    *nan += (size_t)__builtin_popcount(_mm512_cmp_ps_mask(x, x, _CMP_UNORD_Q));
+  }
+  return acos_nvidia_ps512_ax(x, _mm512_min_ps(_mm512_set1_ps(1.0f), ax));
+}
+
+static inline __attribute__((always_inline))
+void acos_clamp_v16(float *out, const float *in, size_t n, const int aligned, const int count,
+                    size_t *clamped, size_t *nan)
+{
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m512 x = aligned ? _mm512_load_ps(in + i) : _mm512_loadu_ps(in + i);
+    x = acos_clamp_ps512(x, count, clamped, nan);
+    if (aligned) _mm512_store_ps(out + i, x); else _mm512_storeu_ps(out + i, x);
+  }
+  if (i < n) {
+    __mmask16 m = (__mmask16)((1u << (n - i)) - 1);
+    __m512 x = acos_clamp_ps512(_mm512_maskz_loadu_ps(m, in + i), count, clamped, nan);
+    _mm512_mask_storeu_ps(out + i, m, x);
+  }
+}
+
+#elif defined(__AVX2__) && defined(__FMA__)
+
+// Compare masks are -1 in each matching lane, so subtracting them counts per lane.
+static inline __attribute__((always_inline))
+__m256 acos_clamp_ps256(__m256 x, const int count, __m256i *clamped, __m256i *nan)
+{
+  __m256 ax = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), x);
+  if (count) {
+    __m256 over = _mm256_cmp_ps(ax, _mm256_set1_ps(1.0f), _CMP_GT_OQ);
+    *clamped = _mm256_sub_epi32(*clamped, _mm256_castps_si256(over));
+    *nan = _mm256_sub_epi32(*nan, _mm256_castps_si256(_mm256_cmp_ps(x, x, _CMP_UNORD_Q)));
+  }
+  return acos_nvidia_ps256_ax(x, _mm256_min_ps(_mm256_set1_ps(1.0f), ax));
+}
+
+static inline size_t acos_clamp_sum8(__m256i v)
+{
+  uint32_t lanes[8];
+  _mm256_storeu_si256((__m256i *)lanes, v);
+  size_t sum = 0;
+  for (int i = 0; i < 8; i++) sum += lanes[i];
+  return sum;
+}
+
+static inline __attribute__((always_inline))
+void acos_clamp_v8(float *out, const float *in, size_t n, const int aligned, const int count,
+                   size_t *clamped, size_t *nan)
+{
+  __m256i c = _mm256_setzero_si256(), u = _mm256_setzero_si256();
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256 x = aligned ? _mm256_load_ps(in + i) : _mm256_loadu_ps(in + i);
+    x = acos_clamp_ps256(x, count, &c, &u);
+    if (aligned) _mm256_store_ps(out + i, x); else _mm256_storeu_ps(out + i, x);
+  }
+  if (i < n) {
+    __m256i m = _mm256_cmpgt_epi32(_mm256_set1_epi32((int)(n - i)),
+                                   _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    __m256 x = acos_clamp_ps256(_mm256_maskload_ps(in + i, m), count, &c, &u);
+    _mm256_maskstore_ps(out + i, m, x);
+  }
+  if (count) {
+    *clamped += acos_clamp_sum8(c);
+    *nan += acos_clamp_sum8(u);
+  }
+}
+
+#else
+
+// Compare masks are -1 in each matching lane, so subtracting them counts per lane.
+static inline __attribute__((always_inline))
+__m128 acos_clamp_ps(__m128 x, const int count, __m128i *clamped, __m128i *nan)
+{
+  __m128 ax = _mm_andnot_ps(_mm_set1_ps(-0.0f), x);
+  if (count) {
+    *clamped = _mm_sub_epi32(*clamped, _mm_castps_si128(_mm_cmpgt_ps(ax, _mm_set1_ps(1.0f))));
+    *nan = _mm_sub_epi32(*nan, _mm_castps_si128(_mm_cmpunord_ps(x, x)));
+  }
+  return acos_nvidia_ps_ax(x, _mm_min_ps(_mm_set1_ps(1.0f), ax));
+}
+
+static inline size_t acos_clamp_sum4(__m128i v)
+{
+  uint32_t lanes[4];
+  _mm_storeu_si128((__m128i *)lanes, v);
+  return (size_t)lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+static inline __attribute__((always_inline))
+void acos_clamp_v4(float *out, const float *in, size_t n, const int aligned, const int count,
+                   size_t *clamped, size_t *nan)
+{
+  __m128i c = _mm_setzero_si128(), u = _mm_setzero_si128();
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128 x = aligned ? _mm_load_ps(in + i) : _mm_loadu_ps(in + i);
+    x = acos_clamp_ps(x, count, &c, &u);
+    if (aligned) _mm_store_ps(out + i, x); else _mm_storeu_ps(out + i, x);
+  }
+  if (i < n) {
+    float buf[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    memcpy(buf, in + i, (n - i) * sizeof(float));
+    _mm_storeu_ps(buf, acos_clamp_ps(_mm_loadu_ps(buf), count, &c, &u));
+    memcpy(out + i, buf, (n - i) * sizeof(float));
+  }
+  if (count) {
+    *clamped += acos_clamp_sum4(c);
+    *nan += acos_clamp_sum4(u);
+  }
+}
+
+#endif
+
+// The counters stay in registers through the loop; the padding lanes of a tail are
+// zeros and count as neither.
+static inline __attribute__((always_inline))
+void acos_clamp_v(float *out, const float *in, size_t n, const int count,
+                  size_t *clamped, size_t *nan)
+{
+#if defined(__AVX512F__)
+  if ((((uintptr_t)out | (uintptr_t)in) & 63) == 0)
+    acos_clamp_v16(out, in, n, 1, count, clamped, nan);
+  else
+    acos_clamp_v16(out, in, n, 0, count, clamped, nan);
+#elif defined(__AVX2__) && defined(__FMA__)
+  if ((((uintptr_t)out | (uintptr_t)in) & 31) == 0)
+    acos_clamp_v8(out, in, n, 1, count, clamped, nan);
+  else
+    acos_clamp_v8(out, in, n, 0, count, clamped, nan);
+#else
+  if ((((uintptr_t)out | (uintptr_t)in) & 15) == 0)
+    acos_clamp_v4(out, in, n, 1, count, clamped, nan);
+  else
+    acos_clamp_v4(out, in, n, 0, count, clamped, nan);
+#endif
+}
+
+void acos_nvidia_clamp_v(float *out, const float *in, size_t n)
+{
+  size_t clamped = 0, nan = 0;
+  acos_clamp_v(out, in, n, 0, &clamped, &nan);
+}
+
+void acos_nvidia_clamp_count_v(float *out, const float *in, size_t n,
+                               struct acos_clamp_counts *counts)
+{
+  size_t clamped = 0, nan = 0;
+  // The SSE and AVX2 lane counters are 32 bits wide; blocks of 2^32 elements, a multiple
+  // of every vector width, keep them from wrapping without changing the alignment.
+  while (n > 0) {
+    size_t m = (n < ACOS_CLAMP_BLOCK) ? n : ACOS_CLAMP_BLOCK;
+    acos_clamp_v(out, in, m, 1, &clamped, &nan);
+    out += m;
+    in += m;
+    n -= m;
+  }
+  counts->clamped += clamped;
+  counts->nan += nan;
+}
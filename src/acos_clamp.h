@@ -0,0 +1,33 @@
+#ifndef __ACOS_CLAMP_H
+#define __ACOS_CLAMP_H
+
+#include <stdlib.h>
+#include <stdint.h>
+#include "acos_nvidia_simd.h"
+
+/// Inputs acos_nvidia_clamp_count_v saw outside [-1, 1]. Each call adds to the fields,
+/// so zero them for per-batch figures or keep them for a running total.
+struct acos_clamp_counts {
+  size_t clamped;  // |x| > 1, infinities included, saturated to acos(±1)
+  size_t nan;      // NaN inputs, which stay NaN
+};
+
+/// acos_nvidia6 for inputs that noise pushes slightly past ±1, such as the DESA cosine.
+/// |x| is saturated with one min(|x|, 1) at the head of the polynomial, so x > 1 gives
+/// 0 and x < -1 gives π instead of NaN, without a branch. NaN inputs still return NaN:
+/// they mean broken data rather than noise. Inside [-1, 1] the results are bitwise
+/// identical to acos_nvidia6.
+float acos_nvidia6_clamp(float x);
+
+/// Batch form: out[i] = acos(in[i]) for i in [0, n) with |x| clamped the same way.
+/// Same vectors, alignment handling and tails as acos_nvidia_v, and the same results
+/// inside [-1, 1]. `out` and `in` may be the same buffer but must not otherwise overlap.
+void acos_nvidia_clamp_v(float *out, const float *in, size_t n);
+
+/// acos_nvidia_clamp_v that also adds the number of clamped and of NaN inputs to
+/// `counts`, for data-quality monitoring. Each vector adds two compares and two
+/// popcounts, off the dependency chain of the result.
+void acos_nvidia_clamp_count_v(float *out, const float *in, size_t n,
+                               struct acos_clamp_counts *counts);
+
+#endif
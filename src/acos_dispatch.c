@@ -0,0 +1,134 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "acos_dispatch.h"
+#include "acos_binomial.h"
+#include "acos_nvidia.h"
+#include "acos_nvidia_v.h"
+#include "acos_minimax.h"
+#include "acos_lut.h"
+#include "acos_inline.h"
+#include "desa.h"
+#include "desa_planar.h"
+#include "acos_double.h"
+#include "acos_half.h"
+#include "acos_q15.h"
+#include "asin_atan.h"
+#include "acos_clamp.h"
+
+#define ACOS_ISA_DECLARE(t, ret, fn, params, args) ret ACOS_ISA_NAME(fn, t) params;
+#define ACOS_ISA_ENTRY(t, ret, fn, params, args) .fn = ACOS_ISA_NAME(fn, t),
+#define ACOS_ISA_TABLE(isa, t)                  \
+  [isa] = { isa, #t,                            \
+            ACOS_SCALAR_KERNELS(ACOS_ISA_ENTRY, t) \
+            ACOS_BATCH_KERNELS(ACOS_ISA_ENTRY, t) \
+            ACOS_DESA_KERNELS(ACOS_ISA_ENTRY, t) \
+            ACOS_PRECISION_SCALAR_KERNELS(ACOS_ISA_ENTRY, t) \
+            ACOS_PRECISION_BATCH_KERNELS(ACOS_ISA_ENTRY, t) \
+            ACOS_TRIG_SCALAR_KERNELS(ACOS_ISA_ENTRY, t) \
+            ACOS_TRIG_BATCH_KERNELS(ACOS_ISA_ENTRY, t) \
+            ACOS_COUNTED_BATCH_KERNELS(ACOS_ISA_ENTRY, t) }
+
+#define ACOS_ISA_DECLARE_ALL(t)                 \
+  ACOS_SCALAR_KERNELS(ACOS_ISA_DECLARE, t)      \
+  ACOS_BATCH_KERNELS(ACOS_ISA_DECLARE, t)       \
+  ACOS_DESA_KERNELS(ACOS_ISA_DECLARE, t)       \
+  ACOS_PRECISION_SCALAR_KERNELS(ACOS_ISA_DECLARE, t) \
+  ACOS_PRECISION_BATCH_KERNELS(ACOS_ISA_DECLARE, t) \
+  ACOS_TRIG_SCALAR_KERNELS(ACOS_ISA_DECLARE, t) \
+  ACOS_TRIG_BATCH_KERNELS(ACOS_ISA_DECLARE, t) \
+  ACOS_COUNTED_BATCH_KERNELS(ACOS_ISA_DECLARE, t)
+
+ACOS_ISA_DECLARE_ALL(baseline)
+ACOS_ISA_DECLARE_ALL(sse42)
+ACOS_ISA_DECLARE_ALL(avx2)
+ACOS_ISA_DECLARE_ALL(avx512)
+
+static const struct acos_kernels acos_isa_tables[ACOS_ISA_COUNT] = {
+  ACOS_ISA_TABLE(ACOS_ISA_BASELINE, baseline),
+  ACOS_ISA_TABLE(ACOS_ISA_SSE42, sse42),
+  ACOS_ISA_TABLE(ACOS_ISA_AVX2, avx2),
+  ACOS_ISA_TABLE(ACOS_ISA_AVX512, avx512),
+};
+
+static const char *acos_isa_names[ACOS_ISA_COUNT] = {
+  [ACOS_ISA_BASELINE] = "baseline",
+  [ACOS_ISA_SSE42] = "sse4.2",
+  [ACOS_ISA_AVX2] = "avx2",
+  [ACOS_ISA_AVX512] = "avx512",
+};
+
+const struct acos_kernels *acos_dispatch = &acos_isa_tables[ACOS_ISA_BASELINE];
+
+enum acos_isa acos_isa_detect(void)
+{
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("x86-64-v4")) return ACOS_ISA_AVX512;
+  if (__builtin_cpu_supports("x86-64-v3")) return ACOS_ISA_AVX2;
+  if (__builtin_cpu_supports("x86-64-v2")) return ACOS_ISA_SSE42;
+  return ACOS_ISA_BASELINE;
+}
+
+const struct acos_kernels *acos_isa_kernels(enum acos_isa isa)
+{
+  return (isa < ACOS_ISA_COUNT) ? &acos_isa_tables[isa] : NULL;
+}
+
+int acos_isa_select(enum acos_isa isa)
+{
+  if (isa >= ACOS_ISA_COUNT || isa > acos_isa_detect()) return -1;
+  acos_dispatch = &acos_isa_tables[isa];
+  return 0;
+}
+
+const char *acos_isa_name(enum acos_isa isa)
+{
+  return (isa < ACOS_ISA_COUNT) ? acos_isa_names[isa] : "unknown";
+}
+
+int acos_isa_parse(const char *s, enum acos_isa *isa)
+{
+  for (int i = 0; i < ACOS_ISA_COUNT; i++) {
+    if (strcmp(s, acos_isa_names[i]) == 0 || strcmp(s, acos_isa_tables[i].suffix) == 0) {
+      *isa = (enum acos_isa)i;
+      return 0;
+    }
+  }
+  return -1;
+}
+
+/// Runs before main(). Picks the best supported tier unless ACOS_APPROX_ISA asks for
+/// a lower one.
+__attribute__((constructor))
+static void acos_isa_init(void)
+{
+  enum acos_isa isa = acos_isa_detect();
+  const char *env = getenv("ACOS_APPROX_ISA");
+  if (env != NULL && *env != '\0') {
+    enum acos_isa forced;
+    if (acos_isa_parse(env, &forced) != 0) {
+      fprintf(stderr, "ACOS_APPROX_ISA: unknown tier '%s', using %s\n", env, acos_isa_name(isa));
+    } else if (forced > isa) {
+      fprintf(stderr, "ACOS_APPROX_ISA: %s not supported by this CPU, using %s\n",
+              acos_isa_name(forced), acos_isa_name(isa));
+    } else {
+      isa = forced;
+    }
+  }
+  acos_dispatch = &acos_isa_tables[isa];
+}
+
+// Public entry points forward to the selected tier.
+#define ACOS_DISPATCH_SCALAR(t, ret, fn, params, args) \
+  ret fn params { return acos_dispatch->fn args; }
+#define ACOS_DISPATCH_BATCH(t, ret, fn, params, args) \
+  ret fn params { acos_dispatch->fn args; }
+
+ACOS_SCALAR_KERNELS(ACOS_DISPATCH_SCALAR, _)
+ACOS_BATCH_KERNELS(ACOS_DISPATCH_BATCH, _)
+ACOS_DESA_KERNELS(ACOS_DISPATCH_SCALAR, _)
+ACOS_PRECISION_SCALAR_KERNELS(ACOS_DISPATCH_SCALAR, _)
+ACOS_PRECISION_BATCH_KERNELS(ACOS_DISPATCH_BATCH, _)
+ACOS_TRIG_SCALAR_KERNELS(ACOS_DISPATCH_SCALAR, _)
+ACOS_TRIG_BATCH_KERNELS(ACOS_DISPATCH_BATCH, _)
+ACOS_COUNTED_BATCH_KERNELS(ACOS_DISPATCH_BATCH, _)
@@ -0,0 +1,146 @@
+#ifndef __ACOS_DISPATCH_H
+#define __ACOS_DISPATCH_H
+
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "acos_isa.h"
+
+/// ISA tiers every kernel is built for. Each tier is a superset of the previous one.
+enum acos_isa {
+  ACOS_ISA_BASELINE,  // x86-64:    SSE2
+  ACOS_ISA_SSE42,     // x86-64-v2: SSE4.2, POPCNT
+  ACOS_ISA_AVX2,      // x86-64-v3: AVX2, FMA, F16C
+  ACOS_ISA_AVX512,    // x86-64-v4: AVX-512F/BW/DQ/VL
+  ACOS_ISA_COUNT
+};
+
+/// Tiered kernels returning a value, as X(tier, return type, name, parameters, arguments).
+#define ACOS_SCALAR_KERNELS(X, t)                              \
+  X(t, float, acos_binomial, (float x, int rounds), (x, rounds)) \
+  X(t, float, acos_binomial_rr, (float x), (x))                \
+  X(t, float, acos_nvidia0, (float x), (x))                    \
+  X(t, float, acos_nvidia1, (float x), (x))                    \
+  X(t, float, acos_nvidia2, (float x), (x))                    \
+  X(t, float, acos_nvidia3, (float x), (x))                    \
+  X(t, float, acos_nvidia4, (float x), (x))                    \
+  X(t, float, acos_nvidia5, (float x), (x))                    \
+  X(t, float, acos_nvidia6, (float x), (x))                    \
+  X(t, float, acos_nvidia7, (float x), (x))                    \
+  X(t, float, acos_nvidia6_clamp, (float x), (x))              \
+  X(t, float, acos_minimax2, (float x), (x))                   \
+  X(t, float, acos_minimax3, (float x), (x))                   \
+  X(t, float, acos_minimax4, (float x), (x))                   \
+  X(t, float, acos_minimax5, (float x), (x))                   \
+  X(t, float, acos_minimax6, (float x), (x))                   \
+  X(t, float, acos_minimax7, (float x), (x))                   \
+  X(t, float, acos_lut_linear, (float x), (x))                 \
+  X(t, float, acos_lut_cubic, (float x), (x))
+
+/// Tiered kernels writing through an output buffer, in the same form.
+#define ACOS_BATCH_KERNELS(X, t)                               \
+  X(t, void, acos_nvidia_v, (float *out, const float *in, size_t n), (out, in, n))     \
+  X(t, void, acos_nvidia_clamp_v, (float *out, const float *in, size_t n), (out, in, n)) \
+  X(t, void, acos_binomial_rr_v, (float *out, const float *in, size_t n), (out, in, n)) \
+  X(t, void, acos_minimax2_v, (float *out, const float *in, size_t n), (out, in, n))   \
+  X(t, void, acos_minimax3_v, (float *out, const float *in, size_t n), (out, in, n))   \
+  X(t, void, acos_minimax4_v, (float *out, const float *in, size_t n), (out, in, n))   \
+  X(t, void, acos_minimax5_v, (float *out, const float *in, size_t n), (out, in, n))   \
+  X(t, void, acos_minimax6_v, (float *out, const float *in, size_t n), (out, in, n))   \
+  X(t, void, acos_minimax7_v, (float *out, const float *in, size_t n), (out, in, n))   \
+  X(t, void, acos_lut_linear_v, (float *out, const float *in, size_t n), (out, in, n)) \
+  X(t, void, acos_lut_cubic_v, (float *out, const float *in, size_t n), (out, in, n)) \
+  X(t, void, acos_nvidia6_loop, (float *out, const float *in, size_t n), (out, in, n)) \
+  X(t, void, acos_minimax4_loop, (float *out, const float *in, size_t n), (out, in, n))
+
+/// Tiered streaming DESA kernels (see desa.h and desa_planar.h), in the same form.
+#define ACOS_DESA_PARAMS (struct desa_state *s, float *freq, float *amp, const float *in, size_t n)
+#define ACOS_DESA_ARGS (s, freq, amp, in, n)
+#define ACOS_DESA_PLANAR_PARAMS (struct desa_state *s, float *const *freq, float *const *amp, \
+                                 const float *const *in, size_t channels, size_t n)
+#define ACOS_DESA_PLANAR_ARGS (s, freq, amp, in, channels, n)
+#define ACOS_DESA_KERNELS(X, t)                                \
+  X(t, size_t, desa1, ACOS_DESA_PARAMS, ACOS_DESA_ARGS)        \
+  X(t, size_t, desa2, ACOS_DESA_PARAMS, ACOS_DESA_ARGS)        \
+  X(t, size_t, desa1_naive, ACOS_DESA_PARAMS, ACOS_DESA_ARGS)  \
+  X(t, size_t, desa2_naive, ACOS_DESA_PARAMS, ACOS_DESA_ARGS)  \
+  X(t, size_t, desa1_planar, ACOS_DESA_PLANAR_PARAMS, ACOS_DESA_PLANAR_ARGS) \
+  X(t, size_t, desa2_planar, ACOS_DESA_PLANAR_PARAMS, ACOS_DESA_PLANAR_ARGS)
+
+struct desa_state;
+
+/// Tiered kernels over other element types (see acos_double.h, acos_half.h and
+/// acos_q15.h): double precision, float results from binary16/bfloat16 inputs, and Q15
+/// fixed point, in the same form.
+#define ACOS_PRECISION_SCALAR_KERNELS(X, t)                    \
+  X(t, double, acos_double, (double x), (x))                   \
+  X(t, int16_t, acos_q15, (int16_t x), (x))
+#define ACOS_PRECISION_BATCH_KERNELS(X, t)                     \
+  X(t, void, acos_double_v, (double *out, const double *in, size_t n), (out, in, n)) \
+  X(t, void, acos_f16_v, (float *out, const uint16_t *in, size_t n), (out, in, n))   \
+  X(t, void, acos_bf16_v, (float *out, const uint16_t *in, size_t n), (out, in, n))   \
+  X(t, void, acos_q15_v, (int16_t *out, const int16_t *in, size_t n), (out, in, n))
+
+/// Tiered asin, atan and atan2 kernels on acos_nvidia6's core (see asin_atan.h), and
+/// the fused acos + asin, in the same form.
+#define ACOS_TRIG_SCALAR_KERNELS(X, t)                         \
+  X(t, float, asin_nvidia, (float x), (x))                     \
+  X(t, float, atan_nvidia, (float x), (x))                     \
+  X(t, float, atan2_nvidia, (float y, float x), (y, x))        \
+  X(t, float, acos_asin_nvidia, (float x, float *asin_x), (x, asin_x))
+#define ACOS_TRIG_BATCH_KERNELS(X, t)                          \
+  X(t, void, asin_nvidia_v, (float *out, const float *in, size_t n), (out, in, n)) \
+  X(t, void, atan_nvidia_v, (float *out, const float *in, size_t n), (out, in, n)) \
+  X(t, void, atan2_nvidia_v, (float *out, const float *y, const float *x, size_t n), (out, y, x, n)) \
+  X(t, void, acos_asin_nvidia_v, (float *acos_out, float *asin_out, const float *in, size_t n), \
+    (acos_out, asin_out, in, n))
+
+/// Tiered clamping batch kernel that also counts out-of-range inputs (see acos_clamp.h),
+/// in the same form.
+#define ACOS_COUNTED_BATCH_KERNELS(X, t)                       \
+  X(t, void, acos_nvidia_clamp_count_v,                        \
+    (float *out, const float *in, size_t n, struct acos_clamp_counts *counts), \
+    (out, in, n, counts))
+
+struct acos_clamp_counts;
+
+#define ACOS_KERNEL_FIELD(t, ret, fn, params, args) ret (*fn) params;
+
+/// One tier's build of every kernel.
+struct acos_kernels {
+  enum acos_isa isa;
+  const char *suffix;  // symbol suffix of this build, e.g. "avx2"
+  ACOS_SCALAR_KERNELS(ACOS_KERNEL_FIELD, _)
+  ACOS_BATCH_KERNELS(ACOS_KERNEL_FIELD, _)
+  ACOS_DESA_KERNELS(ACOS_KERNEL_FIELD, _)
+  ACOS_PRECISION_SCALAR_KERNELS(ACOS_KERNEL_FIELD, _)
+  ACOS_PRECISION_BATCH_KERNELS(ACOS_KERNEL_FIELD, _)
+  ACOS_TRIG_SCALAR_KERNELS(ACOS_KERNEL_FIELD, _)
+  ACOS_TRIG_BATCH_KERNELS(ACOS_KERNEL_FIELD, _)
+  ACOS_COUNTED_BATCH_KERNELS(ACOS_KERNEL_FIELD, _)
+};
+
+/// Kernel table behind the public acos_* entry points.
+///
+/// Starts at the baseline tier and is raised to the best tier the CPU supports before
+/// main() runs. Setting ACOS_APPROX_ISA to baseline, sse4.2, avx2 or avx512 in the
+/// environment forces a lower tier, e.g. for benchmarking.
+extern const struct acos_kernels *acos_dispatch;
+
+/// Returns the best tier supported by the running CPU (and OS, for AVX state).
+enum acos_isa acos_isa_detect(void);
+
+/// Returns the kernel table for `isa`, whether or not the CPU supports it.
+const struct acos_kernels *acos_isa_kernels(enum acos_isa isa);
+
+/// Points acos_dispatch at `isa`. Returns -1 and leaves the dispatch unchanged
+/// if the CPU does not support it.
+int acos_isa_select(enum acos_isa isa);
+
+/// Returns the tier's name as accepted by acos_isa_parse.
+const char *acos_isa_name(enum acos_isa isa);
+
+/// Parses a tier name. Returns 0 on success, -1 if `s` names no tier.
+int acos_isa_parse(const char *s, enum acos_isa *isa);
+
+#endif
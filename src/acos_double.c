@@ -0,0 +1,89 @@
+#include <float.h>
+
+#include "acos_double.h"
+
+// GCC vectors of one double and of the widest lanes this tier has. The kernel body is
+// written once, with plain operators and integer masks for the selects, and
+// instantiated for both so scalar and batch results match exactly.
+#if defined(__AVX512F__)
+#define ACOS_DOUBLE_VBYTES 64
+#elif defined(__AVX__)
+#define ACOS_DOUBLE_VBYTES 32
+#else
+#define ACOS_DOUBLE_VBYTES 16
+#endif
+#define ACOS_DOUBLE_VLANES (ACOS_DOUBLE_VBYTES / (int)sizeof(double))
+typedef double acos_d1 __attribute__((vector_size(sizeof(double))));
+typedef long long acos_l1 __attribute__((vector_size(sizeof(double))));
+typedef double acos_vd __attribute__((vector_size(ACOS_DOUBLE_VBYTES)));
+typedef long long acos_vl __attribute__((vector_size(ACOS_DOUBLE_VBYTES)));
+
+// π/2 split so that PIO2_HI + PIO2_LO carries it to about 2^-106.
+#define ACOS_DOUBLE_PIO2_HI 1.57079632679489655800e+00
+#define ACOS_DOUBLE_PIO2_LO 6.12323399573676603587e-17
+
+static inline acos_d1 acos_double_sqrt1(acos_d1 v)
+{
+  return (acos_d1){ _mm_cvtsd_f64(_mm_sqrt_sd(_mm_setzero_pd(), _mm_set_sd(v[0]))) };
+}
+
+static inline acos_vd acos_double_sqrtv(acos_vd v)
+{
+#if defined(__AVX512F__)
+  return (acos_vd)_mm512_sqrt_pd((__m512d)v);
+#elif defined(__AVX__)
+  return (acos_vd)_mm256_sqrt_pd((__m256d)v);
+#else
+  return (acos_vd)_mm_sqrt_pd((__m128d)v);
+#endif
+}
+
+// u is x itself on the small branch and s on the large one; q = u z P(z), so
+// asin(u) = u + q. t = π/2 - asin(u) is the small result and, doubled, the x < -1/2
+// one; 2 asin(u) is the x > 1/2 one. There the rounding error of s is no longer
+// hidden under π/2, so as in fdlibm s is split into df, its top 26 bits (df^2 is
+// exact), plus the correction c = (z - df^2) / (s + df). DBL_MIN in the denominator
+// only matters at x = ±1, where it turns 0 / 0 into 0.
+#define ACOS_DOUBLE_CORE(name, vd, vl, vsqrt)                                       \
+  static inline vd name(vd x)                                                       \
+  {                                                                                 \
+    static const double c[] = { ACOS_DOUBLE_C };                                    \
+    const vl sign = (vl){ 0 } + (long long)0x8000000000000000ull;                   \
+    const vl high = (vl){ 0 } + (long long)0xffffffff00000000ull;                   \
+    vd ax = (vd)((vl)x & ~sign);                                                    \
+    vl big = (ax > 0.5);                                                            \
+    vl neg = (x < 0.0);                                                             \
+    vd zs = ax * ax;                                                                \
+    vd zb = (1.0 - ax) * 0.5;                                                       \
+    vd z = (vd)((big & (vl)zb) | (~big & (vl)zs));                                  \
+    vd s = vsqrt(zb);                                                               \
+    vd u = (vd)((big & (vl)s) | (~big & (vl)x));                                    \
+    vd q = u * z * ACOS_HORNER11(c, z);                                             \
+    vd t = ACOS_DOUBLE_PIO2_HI - (u - (ACOS_DOUBLE_PIO2_LO - q));                   \
+    vd df = (vd)((vl)s & high);                                                     \
+    vd w = df + (q + (zb - df * df) / (s + df + DBL_MIN));                          \
+    vd rb = 2.0 * (vd)((neg & (vl)t) | (~neg & (vl)w));                             \
+    return (vd)((big & (vl)rb) | (~big & (vl)t));                                   \
+  }
+
+_Static_assert(ACOS_DOUBLE_DEGREE == 11, "acos_double evaluates ACOS_DOUBLE_C with ACOS_HORNER11");
+
+ACOS_DOUBLE_CORE(acos_double_1, acos_d1, acos_l1, acos_double_sqrt1)
+ACOS_DOUBLE_CORE(acos_double_vec, acos_vd, acos_vl, acos_double_sqrtv)
+
+double acos_double(double x)
+{
+  return acos_double_1((acos_d1){ x })[0];
+}
+
+void acos_double_v(double *out, const double *in, size_t n)
+{
+  size_t i = 0;
+  for (; i + ACOS_DOUBLE_VLANES <= n; i += ACOS_DOUBLE_VLANES) {
+    acos_vd x;
+    memcpy(&x, in + i, sizeof(x));
+    x = acos_double_vec(x);
+    memcpy(out + i, &x, sizeof(x));
+  }
+  for (; i < n; i++) out[i] = acos_double(in[i]);
+}
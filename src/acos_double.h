@@ -0,0 +1,37 @@
+#ifndef __ACOS_DOUBLE_H
+#define __ACOS_DOUBLE_H
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <immintrin.h>
+
+#include "acos_double_coeffs.h"
+#include "acos_minimax.h"
+
+/// Double-precision acos for pipelines that stay in double.
+///
+/// The float kernels' p(|x|) * sqrt(1 - |x|) form would need degree 17 or more to reach
+/// double precision, past where the long double Remez fit converges. This instead
+/// reduces to asin on [0, 1/2], where a degree-11 polynomial in z = s^2 suffices
+/// (acos_double_coeffs.h, see acos-remez -d):
+///
+///   |x| <= 1/2:  acos(x) = π/2 - asin(x),                     z = x^2
+///   |x| >  1/2:  acos(|x|) = 2 asin(s),  s = sqrt((1 - |x|) / 2), z = s^2
+///
+/// folded to π - 2 asin(s) for x < -1/2. The polynomial only supplies the s^3 term, so
+/// its error is scaled down by at least 4, and π/2 is carried as two doubles. Both
+/// branches are evaluated and selected with masks, so nothing branches on the input.
+/// Maximum error against acosl over 2^24 random inputs in [-1, 1], half of them
+/// clustered at ±1, is 0.98 ulp.
+/// Inputs outside [-1, 1] give NaN.
+double acos_double(double x);
+
+/// Batch form of acos_double: out[i] = acos(in[i]) for i in [0, n).
+///
+/// Uses 8-wide AVX-512 lanes, 4-wide AVX2 lanes, or 2-wide SSE2 lanes, depending on the
+/// tier. Results are bitwise identical to acos_double. `out` and `in` may be the same
+/// buffer but must not otherwise overlap.
+void acos_double_v(double *out, const double *in, size_t n);
+
+#endif
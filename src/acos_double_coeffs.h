@@ -0,0 +1,28 @@
+#ifndef __ACOS_DOUBLE_COEFFS_H
+#define __ACOS_DOUBLE_COEFFS_H
+
+/// Generated by `acos-remez -d 11`; regenerate with `make coeffs` instead of editing.
+///
+/// asin(s) ~= s + s^3 * (c0 + c1*z + ... + cd*z^d) with z = s^2, s in [0, 1/2], with
+/// c0..cd chosen by Remez exchange to minimize the maximum absolute error of the
+/// polynomial. ACOS_DOUBLE_C lists c0..cd rounded to double.
+/// ACOS_DOUBLE_ERR is the equioscillation level before rounding.
+
+// degree 11: 3 iterations
+#define ACOS_DOUBLE_DEGREE 11
+#define ACOS_DOUBLE_C \
+  1.66666666666666463e-01, \
+  7.50000000002326306e-02, \
+  4.46428570994094470e-02, \
+  3.03819476185180383e-02, \
+  2.23720395602481290e-02, \
+  1.73554110514430350e-02, \
+  1.39278902898741733e-02, \
+  1.18886949389332836e-02, \
+  7.73946017780484906e-03, \
+  1.62250780871672322e-02, \
+  -1.10688362915343317e-02, \
+  2.84021348505643992e-02
+#define ACOS_DOUBLE_ERR 2.061e-16
+
+#endif
@@ -0,0 +1,95 @@
+#include "acos_half.h"
+
+// Per tier: lanes per vector, the two widening loads, and the acos_nvidia_v arithmetic
+// with a store of one full vector.
+#if defined(__AVX512F__)
+
+#define ACOS_HALF_LANES 16
+
+static inline __m512 acos_half_f16(const uint16_t *p)
+{
+  return _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i *)p));
+}
+
+static inline __m512 acos_half_bf16(const uint16_t *p)
+{
+  __m512i h = _mm512_cvtepu16_epi32(_mm256_loadu_si256((const __m256i *)p));
+  return _mm512_castsi512_ps(_mm512_slli_epi32(h, 16));
+}
+
+static inline void acos_half_store(float *out, __m512 x)
+{
+  _mm512_storeu_ps(out, acos_nvidia_ps512(x));
+}
+
+#elif defined(__AVX2__) && defined(__FMA__) && defined(__F16C__)
+
+#define ACOS_HALF_LANES 8
+
+static inline __m256 acos_half_f16(const uint16_t *p)
+{
+  return _mm256_cvtph_ps(_mm_loadu_si128((const __m128i *)p));
+}
+
+static inline __m256 acos_half_bf16(const uint16_t *p)
+{
+  __m256i h = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)p));
+  return _mm256_castsi256_ps(_mm256_slli_epi32(h, 16));
+}
+
+static inline void acos_half_store(float *out, __m256 x)
+{
+  _mm256_storeu_ps(out, acos_nvidia_ps256(x));
+}
+
+#else
+
+#define ACOS_HALF_LANES 4
+
+/// binary16 to float without F16C. Moved into float position, the exponent and mantissa
+/// read as a float 2^112 too small (subnormals included), so one multiply by 2^112
+/// rebiases them exactly; Inf and NaN then get the float exponent forced to all ones.
+static inline __m128 acos_half_f16(const uint16_t *p)
+{
+  __m128i h = _mm_unpacklo_epi16(_mm_loadl_epi64((const __m128i *)p), _mm_setzero_si128());
+  __m128i em = _mm_and_si128(h, _mm_set1_epi32(0x7fff));
+  __m128i sign = _mm_slli_epi32(_mm_xor_si128(h, em), 16);
+  __m128 f = _mm_mul_ps(_mm_castsi128_ps(_mm_slli_epi32(em, 13)),
+                        _mm_castsi128_ps(_mm_set1_epi32(0x77800000)));
+  __m128i special = _mm_cmpgt_epi32(em, _mm_set1_epi32(0x7bff));
+  f = _mm_or_ps(f, _mm_castsi128_ps(_mm_and_si128(special, _mm_set1_epi32(0x7f800000))));
+  return _mm_or_ps(f, _mm_castsi128_ps(sign));
+}
+
+static inline __m128 acos_half_bf16(const uint16_t *p)
+{
+  __m128i h = _mm_loadl_epi64((const __m128i *)p);
+  return _mm_castsi128_ps(_mm_unpacklo_epi16(_mm_setzero_si128(), h));
+}
+
+static inline void acos_half_store(float *out, __m128 x)
+{
+  _mm_storeu_ps(out, acos_nvidia_ps(x));
+}
+
+#endif
+
+// The n % lanes tail goes through a zero-padded bounce buffer, so every element takes
+// the same widening and arithmetic.
+#define ACOS_HALF_BATCH(name, widen)                                \
+  void name(float *out, const uint16_t *in, size_t n)               \
+  {                                                                 \
+    size_t i = 0;                                                   \
+    for (; i + ACOS_HALF_LANES <= n; i += ACOS_HALF_LANES)          \
+      acos_half_store(out + i, widen(in + i));                      \
+    if (i < n) {                                                    \
+      uint16_t h[ACOS_HALF_LANES] = { 0 };                          \
+      float f[ACOS_HALF_LANES];                                     \
+      memcpy(h, in + i, (n - i) * sizeof(uint16_t));                \
+      acos_half_store(f, widen(h));                                 \
+      memcpy(out + i, f, (n - i) * sizeof(float));                  \
+    }                                                               \
+  }
+
+ACOS_HALF_BATCH(acos_f16_v, acos_half_f16)
+ACOS_HALF_BATCH(acos_bf16_v, acos_half_bf16)
@@ -0,0 +1,27 @@
+#ifndef __ACOS_HALF_H
+#define __ACOS_HALF_H
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <immintrin.h>
+
+#include "acos_nvidia_simd.h"
+
+/// Batch acos over 16-bit inputs, for band data archived as IEEE binary16 (acos_f16_v)
+/// or bfloat16 (acos_bf16_v): out[i] = acos(in[i]) for i in [0, n), each in[i] holding
+/// the raw bits of one value.
+///
+/// Each vector of inputs is widened to float in registers and goes straight through the
+/// acos_nvidia_v arithmetic, so the input stream is half the bytes of a float buffer and
+/// no float copy of it is ever written. Widening is exact, so results are bitwise
+/// identical to converting the buffer to float and calling acos_nvidia_v.
+///
+/// binary16 is widened with F16C (vcvtph2ps) on the AVX2 tier, with its 512-bit form on
+/// AVX-512, and with an exact integer/multiply sequence on the SSE tiers. bfloat16 is
+/// the top half of a float, so it is widened with a 16-bit shift on every tier.
+/// Widths are 16 lanes with AVX-512, 8 with AVX2 and 4 otherwise.
+void acos_f16_v(float *out, const uint16_t *in, size_t n);
+void acos_bf16_v(float *out, const uint16_t *in, size_t n);
+
+#endif
@@ -0,0 +1,15 @@
+#include "acos_inline.h"
+
+// Plain caller loops over the header-only kernels. Nothing here is written for SIMD:
+// the Makefile builds this file with -fno-math-errno, and the loops are vectorized by
+// the compiler for each ISA tier.
+
+void acos_nvidia6_loop(float *out, const float *in, size_t n)
+{
+  for (size_t i = 0; i < n; i++) out[i] = acos_nvidia6_inline(in[i]);
+}
+
+void acos_minimax4_loop(float *out, const float *in, size_t n)
+{
+  for (size_t i = 0; i < n; i++) out[i] = acos_minimax4_inline(in[i]);
+}
@@ -0,0 +1,57 @@
+#ifndef __ACOS_INLINE_H
+#define __ACOS_INLINE_H
+
+#include <stdlib.h>
+#include <math.h>
+
+#include "acos_minimax_coeffs.h"
+#include "acos_minimax.h"
+#include "acos_nvidia_simd.h"
+
+/// Header-only builds of the branch-free scalar kernels, for callers that want them
+/// inlined into their own loops instead of calling the library per element.
+///
+/// Each is the same arithmetic as the library kernel of the same name and returns the
+/// same results. The square root is plain sqrtf rather than the _mm_sqrt_ss intrinsic,
+/// which GCC cannot widen, so once inlined a caller's loop such as
+///
+///   for (size_t i = 0; i < n; i++) out[i] = acos_nvidia6_inline(in[i]);
+///
+/// auto-vectorizes to the caller's -march (4, 8 or 16 lanes) like acos_nvidia_v.
+/// That needs -fno-math-errno (or -ffast-math) on the caller, since otherwise every
+/// sqrtf keeps a scalar errno path for negative arguments.
+static inline float acos_nvidia6_inline(float x)
+{
+  float ax = fabsf(x);
+  float ret = ACOS_NVIDIA_C3;
+  ret = ret * ax + ACOS_NVIDIA_C2;
+  ret = ret * ax + ACOS_NVIDIA_C1;
+  ret = ret * ax + ACOS_NVIDIA_C0;
+  ret *= sqrtf(1.0f - ax);
+  return ret + (float)(x < 0.0f) * (ACOS_NVIDIA_PI - 2.0f * ret);
+}
+
+#define ACOS_MINIMAX_INLINE(d)                                      \
+  static inline float acos_minimax##d##_inline(float x)             \
+  {                                                                 \
+    static const float c[] = { ACOS_MINIMAX_C##d };                 \
+    float ax = fabsf(x);                                            \
+    float ret = ACOS_HORNER##d(c, ax) * sqrtf(1.0f - ax);           \
+    return ret + (float)(x < 0.0f) * (ACOS_NVIDIA_PI - 2.0f * ret); \
+  }
+
+ACOS_MINIMAX_INLINE(2)
+ACOS_MINIMAX_INLINE(3)
+ACOS_MINIMAX_INLINE(4)
+ACOS_MINIMAX_INLINE(5)
+ACOS_MINIMAX_INLINE(6)
+ACOS_MINIMAX_INLINE(7)
+
+/// out[i] = acos(in[i]) for i in [0, n), written as a plain loop over
+/// acos_nvidia6_inline / acos_minimax4_inline and left to the auto-vectorizer.
+/// They are tiered batch kernels so that acos-bench can set them against the library
+/// call per element and the hand-written acos_nvidia_v / acos_minimax4_v.
+void acos_nvidia6_loop(float *out, const float *in, size_t n);
+void acos_minimax4_loop(float *out, const float *in, size_t n);
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef __ACOS_ISA_H
+#define __ACOS_ISA_H
+
+/// Kernel sources are compiled once per ISA tier (see ISAS in the Makefile).
+/// Each tiered build force-includes this header with ACOS_ISA_SUFFIX set to the tier,
+/// which renames every exported kernel to <name>_<tier> so the builds can be linked
+/// side by side. acos_dispatch.c then picks one tier at load time.
+///
+/// Every kernel listed in ACOS_SCALAR_KERNELS/ACOS_BATCH_KERNELS/ACOS_DESA_KERNELS and the
+/// other ACOS_*_KERNELS lists of acos_dispatch.h must be renamed here.
+#define ACOS_ISA_PASTE(fn, isa) fn##_##isa
+#define ACOS_ISA_NAME(fn, isa) ACOS_ISA_PASTE(fn, isa)
+
+#ifdef ACOS_ISA_SUFFIX
+#define acos_binomial ACOS_ISA_NAME(acos_binomial, ACOS_ISA_SUFFIX)
+#define acos_binomial_rr ACOS_ISA_NAME(acos_binomial_rr, ACOS_ISA_SUFFIX)
+#define acos_binomial_rr_v ACOS_ISA_NAME(acos_binomial_rr_v, ACOS_ISA_SUFFIX)
+#define acos_nvidia0 ACOS_ISA_NAME(acos_nvidia0, ACOS_ISA_SUFFIX)
+#define acos_nvidia1 ACOS_ISA_NAME(acos_nvidia1, ACOS_ISA_SUFFIX)
+#define acos_nvidia2 ACOS_ISA_NAME(acos_nvidia2, ACOS_ISA_SUFFIX)
+#define acos_nvidia3 ACOS_ISA_NAME(acos_nvidia3, ACOS_ISA_SUFFIX)
+#define acos_nvidia4 ACOS_ISA_NAME(acos_nvidia4, ACOS_ISA_SUFFIX)
+#define acos_nvidia5 ACOS_ISA_NAME(acos_nvidia5, ACOS_ISA_SUFFIX)
+#define acos_nvidia6 ACOS_ISA_NAME(acos_nvidia6, ACOS_ISA_SUFFIX)
+#define acos_nvidia7 ACOS_ISA_NAME(acos_nvidia7, ACOS_ISA_SUFFIX)
+#define acos_nvidia_v ACOS_ISA_NAME(acos_nvidia_v, ACOS_ISA_SUFFIX)
+#define acos_nvidia6_clamp ACOS_ISA_NAME(acos_nvidia6_clamp, ACOS_ISA_SUFFIX)
+#define acos_nvidia_clamp_v ACOS_ISA_NAME(acos_nvidia_clamp_v, ACOS_ISA_SUFFIX)
+#define acos_nvidia_clamp_count_v ACOS_ISA_NAME(acos_nvidia_clamp_count_v, ACOS_ISA_SUFFIX)
+#define acos_minimax2 ACOS_ISA_NAME(acos_minimax2, ACOS_ISA_SUFFIX)
+#define acos_minimax3 ACOS_ISA_NAME(acos_minimax3, ACOS_ISA_SUFFIX)
+#define acos_minimax4 ACOS_ISA_NAME(acos_minimax4, ACOS_ISA_SUFFIX)
+#define acos_minimax5 ACOS_ISA_NAME(acos_minimax5, ACOS_ISA_SUFFIX)
+#define acos_minimax6 ACOS_ISA_NAME(acos_minimax6, ACOS_ISA_SUFFIX)
+#define acos_minimax7 ACOS_ISA_NAME(acos_minimax7, ACOS_ISA_SUFFIX)
+#define acos_minimax2_v ACOS_ISA_NAME(acos_minimax2_v, ACOS_ISA_SUFFIX)
+#define acos_minimax3_v ACOS_ISA_NAME(acos_minimax3_v, ACOS_ISA_SUFFIX)
+#define acos_minimax4_v ACOS_ISA_NAME(acos_minimax4_v, ACOS_ISA_SUFFIX)
+#define acos_minimax5_v ACOS_ISA_NAME(acos_minimax5_v, ACOS_ISA_SUFFIX)
+#define acos_minimax6_v ACOS_ISA_NAME(acos_minimax6_v, ACOS_ISA_SUFFIX)
+#define acos_minimax7_v ACOS_ISA_NAME(acos_minimax7_v, ACOS_ISA_SUFFIX)
+#define acos_lut_linear ACOS_ISA_NAME(acos_lut_linear, ACOS_ISA_SUFFIX)
+#define acos_lut_cubic ACOS_ISA_NAME(acos_lut_cubic, ACOS_ISA_SUFFIX)
+#define acos_lut_linear_v ACOS_ISA_NAME(acos_lut_linear_v, ACOS_ISA_SUFFIX)
+#define acos_lut_cubic_v ACOS_ISA_NAME(acos_lut_cubic_v, ACOS_ISA_SUFFIX)
+#define desa1 ACOS_ISA_NAME(desa1, ACOS_ISA_SUFFIX)
+#define desa2 ACOS_ISA_NAME(desa2, ACOS_ISA_SUFFIX)
+#define desa1_naive ACOS_ISA_NAME(desa1_naive, ACOS_ISA_SUFFIX)
+#define desa2_naive ACOS_ISA_NAME(desa2_naive, ACOS_ISA_SUFFIX)
+#define desa1_planar ACOS_ISA_NAME(desa1_planar, ACOS_ISA_SUFFIX)
+#define desa2_planar ACOS_ISA_NAME(desa2_planar, ACOS_ISA_SUFFIX)
+#define acos_double ACOS_ISA_NAME(acos_double, ACOS_ISA_SUFFIX)
+#define acos_double_v ACOS_ISA_NAME(acos_double_v, ACOS_ISA_SUFFIX)
+#define acos_f16_v ACOS_ISA_NAME(acos_f16_v, ACOS_ISA_SUFFIX)
+#define acos_bf16_v ACOS_ISA_NAME(acos_bf16_v, ACOS_ISA_SUFFIX)
+#define acos_q15 ACOS_ISA_NAME(acos_q15, ACOS_ISA_SUFFIX)
+#define acos_q15_v ACOS_ISA_NAME(acos_q15_v, ACOS_ISA_SUFFIX)
+#define acos_nvidia6_loop ACOS_ISA_NAME(acos_nvidia6_loop, ACOS_ISA_SUFFIX)
+#define acos_minimax4_loop ACOS_ISA_NAME(acos_minimax4_loop, ACOS_ISA_SUFFIX)
+#define asin_nvidia ACOS_ISA_NAME(asin_nvidia, ACOS_ISA_SUFFIX)
+#define atan_nvidia ACOS_ISA_NAME(atan_nvidia, ACOS_ISA_SUFFIX)
+#define atan2_nvidia ACOS_ISA_NAME(atan2_nvidia, ACOS_ISA_SUFFIX)
+#define acos_asin_nvidia ACOS_ISA_NAME(acos_asin_nvidia, ACOS_ISA_SUFFIX)
+#define asin_nvidia_v ACOS_ISA_NAME(asin_nvidia_v, ACOS_ISA_SUFFIX)
+#define atan_nvidia_v ACOS_ISA_NAME(atan_nvidia_v, ACOS_ISA_SUFFIX)
+#define atan2_nvidia_v ACOS_ISA_NAME(atan2_nvidia_v, ACOS_ISA_SUFFIX)
+#define acos_asin_nvidia_v ACOS_ISA_NAME(acos_asin_nvidia_v, ACOS_ISA_SUFFIX)
+#endif
+
+#endif
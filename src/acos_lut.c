@@ -0,0 +1,167 @@
+#include "acos_lut.h"
+
+#define ACOS_LUT_PI 3.14159265358979f
+
+/// Splits x into the table row and the position u in [0, 1] within it. Written with SSE
+/// intrinsics so that NaN (|x| > 1) converts to the defined 0x80000000 and is clamped
+/// into the table like the packed forms, carrying the NaN through u.
+static inline __attribute__((always_inline))
+uint32_t acos_lut_index(float x, float *u)
+{
+  __m128 ax = _mm_andnot_ps(_mm_set_ss(-0.0f), _mm_set_ss(x));
+  __m128 s = _mm_mul_ss(_mm_sqrt_ss(_mm_sub_ss(_mm_set_ss(1.0f), ax)), _mm_set_ss(ACOS_LUT_SIZE));
+  uint32_t i = (uint32_t)_mm_cvttss_si32(s);
+  i = i < ACOS_LUT_SIZE - 1 ? i : ACOS_LUT_SIZE - 1;
+  *u = _mm_cvtss_f32(s) - (float)(int32_t)i;
+  return i;
+}
+
+/// π - r for negative x, as a mask select so that it stays branch-free.
+static inline __attribute__((always_inline))
+float acos_lut_fold(float x, float r)
+{
+  __m128 neg = _mm_cmplt_ss(_mm_set_ss(x), _mm_setzero_ps());
+  __m128 vr = _mm_set_ss(r);
+  __m128 fr = _mm_sub_ss(_mm_set_ss(ACOS_LUT_PI), vr);
+  return _mm_cvtss_f32(_mm_or_ps(_mm_and_ps(neg, fr), _mm_andnot_ps(neg, vr)));
+}
+
+float acos_lut_linear(float x)
+{
+  float u;
+  const float *c = acos_lut_linear_table[acos_lut_index(x, &u)];
+  return acos_lut_fold(x, c[1] * u + c[0]);
+}
+
+float acos_lut_cubic(float x)
+{
+  float u;
+  const float *c = acos_lut_cubic_table[acos_lut_index(x, &u)];
+  return acos_lut_fold(x, ((c[3] * u + c[2]) * u + c[1]) * u + c[0]);
+}
+
+#if defined(__AVX512F__)
+
+static inline __m512i acos_lut_index_ps512(__m512 x, __m512 *u)
+{
+  __m512 ax = _mm512_abs_ps(x);
+  __m512 s = _mm512_mul_ps(_mm512_sqrt_ps(_mm512_sub_ps(_mm512_set1_ps(1.0f), ax)),
+                           _mm512_set1_ps(ACOS_LUT_SIZE));
+  __m512i i = _mm512_min_epu32(_mm512_cvttps_epi32(s), _mm512_set1_epi32(ACOS_LUT_SIZE - 1));
+  *u = _mm512_sub_ps(s, _mm512_cvtepi32_ps(i));
+  return i;
+}
+
+static inline __m512 acos_lut_fold_ps512(__m512 x, __m512 r)
+{
+  __mmask16 neg = _mm512_cmp_ps_mask(x, _mm512_setzero_ps(), _CMP_LT_OQ);
+  return _mm512_mask_sub_ps(r, neg, _mm512_set1_ps(ACOS_LUT_PI), r);
+}
+
+static inline __m512 acos_lut_linear_ps512(__m512 x)
+{
+  __m512 u;
+  __m512i row = _mm512_slli_epi32(acos_lut_index_ps512(x, &u), 1);
+  const float *t = &acos_lut_linear_table[0][0];
+  __m512 c0 = _mm512_i32gather_ps(row, t, 4);
+  __m512 c1 = _mm512_i32gather_ps(row, t + 1, 4);
+  return acos_lut_fold_ps512(x, _mm512_fmadd_ps(c1, u, c0));
+}
+
+static inline __m512 acos_lut_cubic_ps512(__m512 x)
+{
+  __m512 u;
+  __m512i row = _mm512_slli_epi32(acos_lut_index_ps512(x, &u), 2);
+  const float *t = &acos_lut_cubic_table[0][0];
+  __m512 ret = _mm512_i32gather_ps(row, t + 3, 4);
+  ret = _mm512_fmadd_ps(ret, u, _mm512_i32gather_ps(row, t + 2, 4));
+  ret = _mm512_fmadd_ps(ret, u, _mm512_i32gather_ps(row, t + 1, 4));
+  ret = _mm512_fmadd_ps(ret, u, _mm512_i32gather_ps(row, t, 4));
+  return acos_lut_fold_ps512(x, ret);
+}
+
+#define ACOS_LUT_BATCH(name, core)                                              \
+  void name(float *out, const float *in, size_t n)                              \
+  {                                                                             \
+    size_t i = 0;                                                               \
+    for (; i + 16 <= n; i += 16)                                                \
+      _mm512_storeu_ps(out + i, core(_mm512_loadu_ps(in + i)));                 \
+    if (i < n) {                                                                \
+      __mmask16 m = (__mmask16)((1u << (n - i)) - 1);                           \
+      _mm512_mask_storeu_ps(out + i, m, core(_mm512_maskz_loadu_ps(m, in + i))); \
+    }                                                                           \
+  }
+
+ACOS_LUT_BATCH(acos_lut_linear_v, acos_lut_linear_ps512)
+ACOS_LUT_BATCH(acos_lut_cubic_v, acos_lut_cubic_ps512)
+
+#elif defined(__AVX2__) && defined(__FMA__)
+
+static inline __m256i acos_lut_index_ps256(__m256 x, __m256 *u)
+{
+  __m256 ax = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), x);
+  __m256 s = _mm256_mul_ps(_mm256_sqrt_ps(_mm256_sub_ps(_mm256_set1_ps(1.0f), ax)),
+                           _mm256_set1_ps(ACOS_LUT_SIZE));
+  __m256i i = _mm256_min_epu32(_mm256_cvttps_epi32(s), _mm256_set1_epi32(ACOS_LUT_SIZE - 1));
+  *u = _mm256_sub_ps(s, _mm256_cvtepi32_ps(i));
+  return i;
+}
+
+static inline __m256 acos_lut_fold_ps256(__m256 x, __m256 r)
+{
+  __m256 neg = _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_LT_OQ);
+  return _mm256_blendv_ps(r, _mm256_sub_ps(_mm256_set1_ps(ACOS_LUT_PI), r), neg);
+}
+
+static inline __m256 acos_lut_linear_ps256(__m256 x)
+{
+  __m256 u;
+  __m256i row = _mm256_slli_epi32(acos_lut_index_ps256(x, &u), 1);
+  const float *t = &acos_lut_linear_table[0][0];
+  __m256 c0 = _mm256_i32gather_ps(t, row, 4);
+  __m256 c1 = _mm256_i32gather_ps(t + 1, row, 4);
+  return acos_lut_fold_ps256(x, _mm256_fmadd_ps(c1, u, c0));
+}
+
+static inline __m256 acos_lut_cubic_ps256(__m256 x)
+{
+  __m256 u;
+  __m256i row = _mm256_slli_epi32(acos_lut_index_ps256(x, &u), 2);
+  const float *t = &acos_lut_cubic_table[0][0];
+  __m256 ret = _mm256_i32gather_ps(t + 3, row, 4);
+  ret = _mm256_fmadd_ps(ret, u, _mm256_i32gather_ps(t + 2, row, 4));
+  ret = _mm256_fmadd_ps(ret, u, _mm256_i32gather_ps(t + 1, row, 4));
+  ret = _mm256_fmadd_ps(ret, u, _mm256_i32gather_ps(t, row, 4));
+  return acos_lut_fold_ps256(x, ret);
+}
+
+#define ACOS_LUT_BATCH(name, core)                                              \
+  void name(float *out, const float *in, size_t n)                              \
+  {                                                                             \
+    size_t i = 0;                                                               \
+    for (; i + 8 <= n; i += 8)                                                  \
+      _mm256_storeu_ps(out + i, core(_mm256_loadu_ps(in + i)));                 \
+    if (i < n) {                                                                \
+      __m256i m = _mm256_cmpgt_epi32(_mm256_set1_epi32((int)(n - i)),           \
+                                     _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7)); \
+      _mm256_maskstore_ps(out + i, m, core(_mm256_maskload_ps(in + i, m)));     \
+    }                                                                           \
+  }
+
+ACOS_LUT_BATCH(acos_lut_linear_v, acos_lut_linear_ps256)
+ACOS_LUT_BATCH(acos_lut_cubic_v, acos_lut_cubic_ps256)
+
+#else
+
+// No gather before AVX2: a packed index would have to be spilled and reloaded lane by
+// lane, which is what the scalar kernel already does.
+#define ACOS_LUT_BATCH(name, scalar)                                            \
+  void name(float *out, const float *in, size_t n)                              \
+  {                                                                             \
+    for (size_t i = 0; i < n; i++) out[i] = scalar(in[i]);                      \
+  }
+
+ACOS_LUT_BATCH(acos_lut_linear_v, acos_lut_linear)
+ACOS_LUT_BATCH(acos_lut_cubic_v, acos_lut_cubic)
+
+#endif
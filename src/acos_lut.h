@@ -0,0 +1,36 @@
+#ifndef __ACOS_LUT_H
+#define __ACOS_LUT_H
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <immintrin.h>
+
+#include "acos_lut_table.h"
+
+/// Table-driven acos. t = sqrt(1 - |x|) indexes a uniform table of ACOS_LUT_SIZE intervals
+/// (see acos_lut_table.h), the fractional position interpolates within the interval, and
+/// negative inputs are folded to π - r. Inputs outside [-1, 1] give NaN.
+///
+/// acos_lut_linear reads one 8-byte row per call; acos_lut_cubic reads one 16-byte row
+/// and spends three more FMAs. Maximum absolute error over every float in [-1, 1]
+/// (acos-approx -e); the cubic is already at float rounding with the L1 table:
+///
+/// | LUT_BITS | linear | cubic  |
+/// |----------|--------|--------|
+/// | 8        | 2.0e-6 | 4.0e-7 |
+/// | 12       | 4.1e-7 | 4.0e-7 |
+float acos_lut_linear(float x);
+float acos_lut_cubic(float x);
+
+/// Batch forms of acos_lut_linear and acos_lut_cubic: out[i] = acos(in[i]) for i in [0, n).
+///
+/// With AVX2 the rows are fetched with 8-wide gathers (16-wide with AVX-512), one gather
+/// per coefficient; the tail is handled with masked loads/stores. Without AVX2 the
+/// scalar kernel is applied element by element. Results are bitwise identical to the
+/// scalar kernels. `out` and `in` may be the same buffer but must not otherwise overlap.
+void acos_lut_linear_v(float *out, const float *in, size_t n);
+void acos_lut_cubic_v(float *out, const float *in, size_t n);
+
+#endif
@@ -0,0 +1,30 @@
+#include "acos_lut_table.h"
+
+float acos_lut_linear_table[ACOS_LUT_SIZE][2] __attribute__((aligned(64)));
+float acos_lut_cubic_table[ACOS_LUT_SIZE][4] __attribute__((aligned(64)));
+
+/// f(t) = acos(1 - t^2) and its derivatives, in double.
+static double acos_lut_f(double t) { return acos(1.0 - t * t); }
+static double acos_lut_df(double t) { return 2.0 / sqrt(2.0 - t * t); }
+static double acos_lut_d2f(double t) { return 2.0 * t / pow(2.0 - t * t, 1.5); }
+
+__attribute__((constructor))
+static void acos_lut_init(void)
+{
+  const double h = 1.0 / ACOS_LUT_SIZE;
+  for (int i = 0; i < ACOS_LUT_SIZE; i++) {
+    double t0 = i * h, t1 = t0 + h;
+    double f0 = acos_lut_f(t0), f1 = acos_lut_f(t1);
+    // f is convex, so the chord lies above it by about h^2 / 8 * f'' at the midpoint.
+    // f''(0) = 0, so the first interval is left alone to keep acos(1) = 0 exact.
+    double sag = (i == 0) ? 0.0 : h * h / 8.0 * acos_lut_d2f(t0 + 0.5 * h);
+    acos_lut_linear_table[i][0] = (float)(f0 - 0.5 * sag);
+    acos_lut_linear_table[i][1] = (float)(f1 - f0);
+
+    double d0 = acos_lut_df(t0) * h, d1 = acos_lut_df(t1) * h;
+    acos_lut_cubic_table[i][0] = (float)f0;
+    acos_lut_cubic_table[i][1] = (float)d0;
+    acos_lut_cubic_table[i][2] = (float)(3.0 * (f1 - f0) - 2.0 * d0 - d1);
+    acos_lut_cubic_table[i][3] = (float)(2.0 * (f0 - f1) + d0 + d1);
+  }
+}
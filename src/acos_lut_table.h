@@ -0,0 +1,38 @@
+#ifndef __ACOS_LUT_TABLE_H
+#define __ACOS_LUT_TABLE_H
+
+#include <stdlib.h>
+#include <math.h>
+
+/// log2 of the number of table intervals. Set at build time (make LUT_BITS=n) to pick the
+/// cache level the tables live in:
+///
+/// | LUT_BITS | linear   | cubic    | fits |
+/// |----------|----------|----------|------|
+/// | 8        | 2 KiB    | 4 KiB    | L1D  |
+/// | 12       | 32 KiB   | 64 KiB   | L2   |
+#ifndef ACOS_LUT_BITS
+#define ACOS_LUT_BITS 8
+#endif
+
+#if ACOS_LUT_BITS < 1 || ACOS_LUT_BITS > 20
+#error "ACOS_LUT_BITS must be in [1, 20]"
+#endif
+
+#define ACOS_LUT_SIZE (1 << ACOS_LUT_BITS)
+
+/// Tables for acos(1 - t^2) over t = sqrt(1 - |x|) in [0, 1], one row per interval
+/// [i, i + 1] / ACOS_LUT_SIZE, in the local coordinate u = t * ACOS_LUT_SIZE - i:
+///
+/// - linear: c0 + c1 * u, the chord lowered by half its midpoint sag so the error is
+///   balanced around zero (except the first interval, so that acos(1) stays 0).
+/// - cubic:  c0 + c1 * u + c2 * u^2 + c3 * u^3, the Hermite cubic matching value and
+///   slope at both ends.
+///
+/// Indexing by t rather than x spends the table where acos is steep: acos(1 - t^2) has
+/// bounded derivatives on [0, 1], so a uniform grid in t is a refined grid near ±1.
+/// Shared by every ISA tier and filled once at load time.
+extern float acos_lut_linear_table[ACOS_LUT_SIZE][2];
+extern float acos_lut_cubic_table[ACOS_LUT_SIZE][4];
+
+#endif
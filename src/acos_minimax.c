@@ -0,0 +1,66 @@
+#include "acos_minimax.h"
+
+// GCC vector of the widest lanes this tier has. Arithmetic on it is written with plain
+// operators so the same ACOS_HORNER expansion serves the scalar and batch kernels.
+#if defined(__AVX512F__)
+#define ACOS_VBYTES 64
+#elif defined(__AVX__)
+#define ACOS_VBYTES 32
+#else
+#define ACOS_VBYTES 16
+#endif
+#define ACOS_VLANES (ACOS_VBYTES / (int)sizeof(float))
+typedef float acos_vf __attribute__((vector_size(ACOS_VBYTES)));
+typedef int acos_vi __attribute__((vector_size(ACOS_VBYTES)));
+
+static inline float acos_sqrt_ss(float f)
+{
+  return _mm_cvtss_f32(_mm_sqrt_ss(_mm_set_ss(f)));
+}
+
+static inline acos_vf acos_sqrt_v(acos_vf v)
+{
+#if defined(__AVX512F__)
+  return (acos_vf)_mm512_sqrt_ps((__m512)v);
+#elif defined(__AVX__)
+  return (acos_vf)_mm256_sqrt_ps((__m256)v);
+#else
+  return (acos_vf)_mm_sqrt_ps((__m128)v);
+#endif
+}
+
+// The sign fixup is acos_nvidia6's r + neg * (pi - 2r) in both forms, so scalar and
+// batch results match exactly and neither branches on the sign.
+#define ACOS_MINIMAX_KERNELS(d)                                             \
+  float acos_minimax##d(float x)                                            \
+  {                                                                         \
+    static const float c[] = { ACOS_MINIMAX_C##d };                         \
+    float ax = fabsf(x);                                                    \
+    float ret = ACOS_HORNER##d(c, ax) * acos_sqrt_ss(1.0f - ax);            \
+    return ret + (float)(x < 0.0f) * (ACOS_NVIDIA_PI - 2.0f * ret);         \
+  }                                                                         \
+                                                                            \
+  void acos_minimax##d##_v(float *out, const float *in, size_t n)           \
+  {                                                                         \
+    static const float c[] = { ACOS_MINIMAX_C##d };                         \
+    const acos_vi sign = (acos_vi){ 0 } + (int)0x80000000;                  \
+    const acos_vi one = (acos_vi)((acos_vf){ 0 } + 1.0f);                   \
+    size_t i = 0;                                                           \
+    for (; i + ACOS_VLANES <= n; i += ACOS_VLANES) {                        \
+      acos_vf x, ax, ret;                                                   \
+      memcpy(&x, in + i, sizeof(x));                                        \
+      acos_vf neg = (acos_vf)((x < (acos_vf){ 0 }) & one);                  \
+      ax = (acos_vf)((acos_vi)x & ~sign);                                   \
+      ret = ACOS_HORNER##d(c, ax) * acos_sqrt_v(1.0f - ax);                 \
+      ret = ret + neg * (ACOS_NVIDIA_PI - 2.0f * ret);                      \
+      memcpy(out + i, &ret, sizeof(ret));                                   \
+    }                                                                       \
+    for (; i < n; i++) out[i] = acos_minimax##d(in[i]);                     \
+  }
+
+ACOS_MINIMAX_KERNELS(2)
+ACOS_MINIMAX_KERNELS(3)
+ACOS_MINIMAX_KERNELS(4)
+ACOS_MINIMAX_KERNELS(5)
+ACOS_MINIMAX_KERNELS(6)
+ACOS_MINIMAX_KERNELS(7)
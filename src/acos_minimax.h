@@ -0,0 +1,52 @@
+#ifndef __ACOS_MINIMAX_H
+#define __ACOS_MINIMAX_H
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <immintrin.h>
+
+#include "acos_minimax_coeffs.h"
+#include "acos_nvidia_simd.h"
+
+/// Horner evaluation of c[0] + c[1]*x + ... + c[d]*x^d, unrolled by the preprocessor so
+/// each degree is a straight multiply-add (FMA where available) chain with no loop.
+/// Works for float, double and for GCC vector types, since scalar operands are broadcast.
+#define ACOS_HORNER0(c, x) ((c)[0])
+#define ACOS_HORNER1(c, x) (ACOS_HORNER0((c) + 1, x) * (x) + (c)[0])
+#define ACOS_HORNER2(c, x) (ACOS_HORNER1((c) + 1, x) * (x) + (c)[0])
+#define ACOS_HORNER3(c, x) (ACOS_HORNER2((c) + 1, x) * (x) + (c)[0])
+#define ACOS_HORNER4(c, x) (ACOS_HORNER3((c) + 1, x) * (x) + (c)[0])
+#define ACOS_HORNER5(c, x) (ACOS_HORNER4((c) + 1, x) * (x) + (c)[0])
+#define ACOS_HORNER6(c, x) (ACOS_HORNER5((c) + 1, x) * (x) + (c)[0])
+#define ACOS_HORNER7(c, x) (ACOS_HORNER6((c) + 1, x) * (x) + (c)[0])
+#define ACOS_HORNER8(c, x) (ACOS_HORNER7((c) + 1, x) * (x) + (c)[0])
+#define ACOS_HORNER9(c, x) (ACOS_HORNER8((c) + 1, x) * (x) + (c)[0])
+#define ACOS_HORNER10(c, x) (ACOS_HORNER9((c) + 1, x) * (x) + (c)[0])
+#define ACOS_HORNER11(c, x) (ACOS_HORNER10((c) + 1, x) * (x) + (c)[0])
+
+/// acos(x) ~= p(|x|) * sqrt(1 - |x|), folded to π - r for x < 0, with p the degree-d
+/// minimax polynomial from acos_minimax_coeffs.h (see acos-remez).
+/// Maximum absolute error over every float in [-1, 1] (acos-approx -e); from degree 5 on,
+/// float rounding near π dominates ACOS_MINIMAX_ERRd:
+///
+/// | degree | 2      | 3      | 4      | 5      | 6      | 7      |
+/// |--------|--------|--------|--------|--------|--------|--------|
+/// | error  | 3.3e-4 | 3.8e-5 | 5.1e-6 | 9.7e-7 | 4.4e-7 | 3.5e-7 |
+float acos_minimax2(float x);
+float acos_minimax3(float x);
+float acos_minimax4(float x);
+float acos_minimax5(float x);
+float acos_minimax6(float x);
+float acos_minimax7(float x);
+
+/// Batch forms of acos_minimax2..7: out[i] = acos(in[i]) for i in [0, n).
+/// Results are bitwise identical to the scalar kernels of the same degree.
+void acos_minimax2_v(float *out, const float *in, size_t n);
+void acos_minimax3_v(float *out, const float *in, size_t n);
+void acos_minimax4_v(float *out, const float *in, size_t n);
+void acos_minimax5_v(float *out, const float *in, size_t n);
+void acos_minimax6_v(float *out, const float *in, size_t n);
+void acos_minimax7_v(float *out, const float *in, size_t n);
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef __ACOS_MINIMAX_COEFFS_H
+#define __ACOS_MINIMAX_COEFFS_H
+
+/// Generated by `acos-remez 2 7`; regenerate with `make coeffs` instead of editing.
+///
+/// acos(x) ~= (c0 + c1*x + ... + cd*x^d) * sqrt(1 - x) on [0, 1], with c0..cd chosen
+/// by Remez exchange to minimize the maximum absolute error of acos.
+/// ACOS_MINIMAX_Cd lists c0..cd rounded to float.
+/// ACOS_MINIMAX_ERRd is the equioscillation level before rounding.
+
+// degree 2: 4 iterations
+#define ACOS_MINIMAX_C2 1.570470214e+00f, -2.054975480e-01f, 5.138953403e-02f
+#define ACOS_MINIMAX_ERR2 3.261e-04
+
+// degree 3: 5 iterations
+#define ACOS_MINIMAX_C3 1.570758343e+00f, -2.128751874e-01f, 7.689739019e-02f, -2.089203708e-02f
+#define ACOS_MINIMAX_ERR3 3.799e-05
+
+// degree 4: 5 iterations
+#define ACOS_MINIMAX_C4 1.570791483e+00f, -2.142806053e-01f, 8.563838154e-02f, -3.761821985e-02f, 9.732970037e-03f
+#define ACOS_MINIMAX_ERR4 4.793e-06
+
+// degree 5: 5 iterations
+#define ACOS_MINIMAX_C5 1.570795655e+00f, -2.145428210e-01f, 8.817104995e-02f, -4.592723027e-02f, 2.062006108e-02f, -4.911174532e-03f
+#define ACOS_MINIMAX_ERR5 6.373e-07
+
+// degree 6: 5 iterations
+#define ACOS_MINIMAX_C6 1.570796251e+00f, -2.145910859e-01f, 8.883588761e-02f, -4.919743910e-02f, 2.776291408e-02f, -1.200339664e-02f, 2.611721167e-03f
+#define ACOS_MINIMAX_ERR6 8.794e-08
+
+// degree 7: 5 iterations
+#define ACOS_MINIMAX_C7 1.570796371e+00f, -2.145998925e-01f, 8.899926394e-02f, -5.031278357e-02f, 3.133547306e-02f, -1.780898683e-02f, 7.245450746e-03f, -1.441480708e-03f
+#define ACOS_MINIMAX_ERR7 1.248e-08
+
+#endif
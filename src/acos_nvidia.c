@@ -1,4 +1,5 @@
 #include "acos_nvidia.h"
+#include "acos_nvidia_simd.h"
 
 /// 0x0000555555555500 <+0>:     endbr64
 /// 0x0000555555555504 <+4>:     sub    $0x18,%rsp
@@ -331,7 +332,7 @@ float acos_nvidia5(float x) {
 
 
 // Source: https://stackoverflow.com/questions/59644197/inverse-square-root-intrinsics
-inline float _mm_sqrt32(const float f)
+static inline float _mm_sqrt32(const float f)
 {
     __m128 temp = _mm_set_ss(f);
     temp = _mm_sqrt_ss(temp);
@@ -366,3 +367,26 @@ float acos_nvidia6(float x) {
   ret *= _mm_sqrt32(1.0f - x);
   return ret + (float)(x0 < 0.0f) * (3.14159265358979f - 2.0f * ret);
 }
+
+// Negative inputs fold to π - r as in acos_nvidia_ps, but the sign is applied to p before
+// the multiply so that the fold and the product are one FMA after the square root. The
+// whole kernel stays in the low lane of one register: going through float locals makes
+// GCC re-zero the upper lanes (vinsertps) before the square root, on the critical path.
+#if defined(__FMA__)
+#define ACOS_NVIDIA7_FMA(a, b, c) _mm_fmadd_ss(a, b, c)
+#else
+#define ACOS_NVIDIA7_FMA(a, b, c) _mm_add_ss(_mm_mul_ss(a, b), c)
+#endif
+
+float acos_nvidia7(float x) {
+  const __m128 vx = _mm_set_ss(x);
+  const __m128 sign = _mm_set_ss(-0.0f);
+  __m128 ax = _mm_andnot_ps(sign, vx);
+  __m128 s = _mm_sqrt_ss(_mm_sub_ss(_mm_set_ss(1.0f), ax));
+  __m128 x2 = _mm_mul_ss(ax, ax);
+  __m128 hi = ACOS_NVIDIA7_FMA(_mm_set_ss(ACOS_NVIDIA_C3), ax, _mm_set_ss(ACOS_NVIDIA_C2));
+  __m128 lo = ACOS_NVIDIA7_FMA(_mm_set_ss(ACOS_NVIDIA_C1), ax, _mm_set_ss(ACOS_NVIDIA_C0));
+  __m128 p = _mm_xor_ps(ACOS_NVIDIA7_FMA(hi, x2, lo), _mm_and_ps(vx, sign));
+  __m128 neg = _mm_castsi128_ps(_mm_srai_epi32(_mm_castps_si128(vx), 31));
+  return _mm_cvtss_f32(ACOS_NVIDIA7_FMA(p, s, _mm_and_ps(neg, _mm_set_ss(ACOS_NVIDIA_PI))));
+}
@@ -33,4 +33,13 @@ float acos_nvidia5(float x);
 /// cf. https://stackoverflow.com/questions/59644197/inverse-square-root-intrinsics
 float acos_nvidia6(float x);
 
+/// Iteration 7: Shorten the dependency chain for callers that feed each result into the
+/// next input. sqrt(1 - |x|) is issued first and overlaps the polynomial, which is
+/// evaluated Estrin-style ((c3 x + c2) x^2 + (c1 x + c0)) in two FMA levels instead of
+/// three. x's sign bit is applied to the polynomial and turned into a π-or-0 offset
+/// alongside, so the square root is followed by a single FMA instead of the multiply and
+/// two-FMA blend of acos_nvidia6. Negative inputs give π - r rather than
+/// r + (π - 2r), so results can differ from acos_nvidia6 in the last bit.
+float acos_nvidia7(float x);
+
 #endif
@@ -0,0 +1,99 @@
+#ifndef __ACOS_NVIDIA_SIMD_H
+#define __ACOS_NVIDIA_SIMD_H
+
+#include <math.h>
+#include <immintrin.h>
+
+/// Abramowitz & Stegun coefficients used by every acos_nvidia kernel.
+#define ACOS_NVIDIA_C3 -0.0187293f
+#define ACOS_NVIDIA_C2  0.0742610f
+#define ACOS_NVIDIA_C1 -0.2121144f
+#define ACOS_NVIDIA_C0  1.5707288f
+#define ACOS_NVIDIA_PI  3.14159265358979f
+
+/// acos_nvidia_ss from x and a precomputed |x|, or |x| clamped to 1 (see acos_clamp.h).
+static inline float acos_nvidia_ss_ax(float x, float ax)
+{
+  float ret = ACOS_NVIDIA_C3;
+  ret = ret * ax + ACOS_NVIDIA_C2;
+  ret = ret * ax + ACOS_NVIDIA_C1;
+  ret = ret * ax + ACOS_NVIDIA_C0;
+  ret *= _mm_cvtss_f32(_mm_sqrt_ss(_mm_set_ss(1.0f - ax)));
+  return ret + (float)(x < 0.0f) * (ACOS_NVIDIA_PI - 2.0f * ret);
+}
+
+/// acos_nvidia6 for inlining into other kernels; same arithmetic, same results.
+static inline float acos_nvidia_ss(float x)
+{
+  return acos_nvidia_ss_ax(x, fabsf(x));
+}
+
+/// Packed form of acos_nvidia6 over 4 lanes. The _ax form takes |x| (or |x| clamped to
+/// 1) separately, as do the wider ones.
+///
+/// Negative lanes are folded to π - r by flipping the sign bit of r under the
+/// `x < 0` mask and adding π under the same mask, so there is no branch and no blend.
+/// Without FMA (baseline x86-64) the Horner chain falls back to mul/add pairs.
+static inline __m128 acos_nvidia_ps_ax(__m128 x, __m128 ax)
+{
+  const __m128 sign = _mm_set1_ps(-0.0f);
+  __m128 neg = _mm_cmplt_ps(x, _mm_setzero_ps());
+#if defined(__FMA__)
+  __m128 ret = _mm_fmadd_ps(_mm_set1_ps(ACOS_NVIDIA_C3), ax, _mm_set1_ps(ACOS_NVIDIA_C2));
+  ret = _mm_fmadd_ps(ret, ax, _mm_set1_ps(ACOS_NVIDIA_C1));
+  ret = _mm_fmadd_ps(ret, ax, _mm_set1_ps(ACOS_NVIDIA_C0));
+#else
+  __m128 ret = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(ACOS_NVIDIA_C3), ax), _mm_set1_ps(ACOS_NVIDIA_C2));
+  ret = _mm_add_ps(_mm_mul_ps(ret, ax), _mm_set1_ps(ACOS_NVIDIA_C1));
+  ret = _mm_add_ps(_mm_mul_ps(ret, ax), _mm_set1_ps(ACOS_NVIDIA_C0));
+#endif
+  ret = _mm_mul_ps(ret, _mm_sqrt_ps(_mm_sub_ps(_mm_set1_ps(1.0f), ax)));
+  ret = _mm_xor_ps(ret, _mm_and_ps(neg, sign));
+  return _mm_add_ps(ret, _mm_and_ps(neg, _mm_set1_ps(ACOS_NVIDIA_PI)));
+}
+
+static inline __m128 acos_nvidia_ps(__m128 x)
+{
+  return acos_nvidia_ps_ax(x, _mm_andnot_ps(_mm_set1_ps(-0.0f), x));
+}
+
+#if defined(__AVX2__) && defined(__FMA__)
+/// Packed form of acos_nvidia6 over 8 lanes. Same sign handling as acos_nvidia_ps.
+static inline __m256 acos_nvidia_ps256_ax(__m256 x, __m256 ax)
+{
+  const __m256 sign = _mm256_set1_ps(-0.0f);
+  __m256 neg = _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_LT_OQ);
+  __m256 ret = _mm256_fmadd_ps(_mm256_set1_ps(ACOS_NVIDIA_C3), ax, _mm256_set1_ps(ACOS_NVIDIA_C2));
+  ret = _mm256_fmadd_ps(ret, ax, _mm256_set1_ps(ACOS_NVIDIA_C1));
+  ret = _mm256_fmadd_ps(ret, ax, _mm256_set1_ps(ACOS_NVIDIA_C0));
+  ret = _mm256_mul_ps(ret, _mm256_sqrt_ps(_mm256_sub_ps(_mm256_set1_ps(1.0f), ax)));
+  ret = _mm256_xor_ps(ret, _mm256_and_ps(neg, sign));
+  return _mm256_add_ps(ret, _mm256_and_ps(neg, _mm256_set1_ps(ACOS_NVIDIA_PI)));
+}
+
+static inline __m256 acos_nvidia_ps256(__m256 x)
+{
+  return acos_nvidia_ps256_ax(x, _mm256_andnot_ps(_mm256_set1_ps(-0.0f), x));
+}
+#endif
+
+#if defined(__AVX512F__)
+/// Packed form of acos_nvidia6 over 16 lanes.
+/// The sign fixup is a single masked subtraction π - r on the negative lanes.
+static inline __m512 acos_nvidia_ps512_ax(__m512 x, __m512 ax)
+{
+  __mmask16 neg = _mm512_cmp_ps_mask(x, _mm512_setzero_ps(), _CMP_LT_OQ);
+  __m512 ret = _mm512_fmadd_ps(_mm512_set1_ps(ACOS_NVIDIA_C3), ax, _mm512_set1_ps(ACOS_NVIDIA_C2));
+  ret = _mm512_fmadd_ps(ret, ax, _mm512_set1_ps(ACOS_NVIDIA_C1));
+  ret = _mm512_fmadd_ps(ret, ax, _mm512_set1_ps(ACOS_NVIDIA_C0));
+  ret = _mm512_mul_ps(ret, _mm512_sqrt_ps(_mm512_sub_ps(_mm512_set1_ps(1.0f), ax)));
+  return _mm512_mask_sub_ps(ret, neg, _mm512_set1_ps(ACOS_NVIDIA_PI), ret);
+}
+
+static inline __m512 acos_nvidia_ps512(__m512 x)
+{
+  return acos_nvidia_ps512_ax(x, _mm512_abs_ps(x));
+}
+#endif
+
+#endif
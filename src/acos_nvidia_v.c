@@ -0,0 +1,78 @@
+#include <string.h>
+#include "acos_nvidia_v.h"
+
+#if defined(__AVX512F__)
+
+static inline __attribute__((always_inline))
+void acos_nvidia_v16(float *out, const float *in, size_t n, const int aligned)
+{
+  size_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m512 x = aligned ? _mm512_load_ps(in + i) : _mm512_loadu_ps(in + i);
+    x = acos_nvidia_ps512(x);
+    if (aligned) _mm512_store_ps(out + i, x); else _mm512_storeu_ps(out + i, x);
+  }
+  if (i < n) {
+    __mmask16 m = (__mmask16)((1u << (n - i)) - 1);
+    _mm512_mask_storeu_ps(out + i, m, acos_nvidia_ps512(_mm512_maskz_loadu_ps(m, in + i)));
+  }
+}
+
+#elif defined(__AVX2__) && defined(__FMA__)
+
+static inline __attribute__((always_inline))
+void acos_nvidia_v8(float *out, const float *in, size_t n, const int aligned)
+{
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256 x = aligned ? _mm256_load_ps(in + i) : _mm256_loadu_ps(in + i);
+    x = acos_nvidia_ps256(x);
+    if (aligned) _mm256_store_ps(out + i, x); else _mm256_storeu_ps(out + i, x);
+  }
+  if (i < n) {
+    __m256i m = _mm256_cmpgt_epi32(_mm256_set1_epi32((int)(n - i)),
+                                   _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    _mm256_maskstore_ps(out + i, m, acos_nvidia_ps256(_mm256_maskload_ps(in + i, m)));
+  }
+}
+
+#else
+
+static inline __attribute__((always_inline))
+void acos_nvidia_v4(float *out, const float *in, size_t n, const int aligned)
+{
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128 x = aligned ? _mm_load_ps(in + i) : _mm_loadu_ps(in + i);
+    x = acos_nvidia_ps(x);
+    if (aligned) _mm_store_ps(out + i, x); else _mm_storeu_ps(out + i, x);
+  }
+  if (i < n) {
+    float buf[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    memcpy(buf, in + i, (n - i) * sizeof(float));
+    _mm_storeu_ps(buf, acos_nvidia_ps(_mm_loadu_ps(buf)));
+    memcpy(out + i, buf, (n - i) * sizeof(float));
+  }
+}
+
+#endif
+
+void acos_nvidia_v(float *out, const float *in, size_t n)
+{
+#if defined(__AVX512F__)
+  if ((((uintptr_t)out | (uintptr_t)in) & 63) == 0)
+    acos_nvidia_v16(out, in, n, 1);
+  else
+    acos_nvidia_v16(out, in, n, 0);
+#elif defined(__AVX2__) && defined(__FMA__)
+  if ((((uintptr_t)out | (uintptr_t)in) & 31) == 0)
+    acos_nvidia_v8(out, in, n, 1);
+  else
+    acos_nvidia_v8(out, in, n, 0);
+#else
+  if ((((uintptr_t)out | (uintptr_t)in) & 15) == 0)
+    acos_nvidia_v4(out, in, n, 1);
+  else
+    acos_nvidia_v4(out, in, n, 0);
+#endif
+}
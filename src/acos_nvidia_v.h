@@ -0,0 +1,18 @@
+#ifndef __ACOS_NVIDIA_V_H
+#define __ACOS_NVIDIA_V_H
+
+#include <stdlib.h>
+#include <stdint.h>
+#include "acos_nvidia_simd.h"
+
+/// Batch form of acos_nvidia6: out[i] = acos(in[i]) for i in [0, n).
+///
+/// Uses 16-wide AVX-512 lanes when built with AVX-512F, 8-wide AVX2+FMA lanes when
+/// built with AVX2 and FMA, and 4-wide SSE lanes otherwise.
+/// When both pointers are aligned to the vector width, aligned loads and stores are used.
+/// The n % width tail is handled with masked loads/stores (AVX2, AVX-512)
+/// or a bounce buffer (SSE), so every element goes through the same packed arithmetic.
+/// `out` and `in` may be the same buffer but must not otherwise overlap.
+void acos_nvidia_v(float *out, const float *in, size_t n);
+
+#endif
@@ -0,0 +1,153 @@
+#include "acos_parallel.h"
+
+/// One job and the state the workers synchronize on. `lock` guards everything below it.
+struct acos_pool {
+  pthread_mutex_t call;  // serializes acos_parallel callers
+  pthread_mutex_t lock;
+  pthread_cond_t start;
+  pthread_cond_t done;
+  pthread_t *threads;    // size - 1 workers; participant 0 is the caller
+  int size;
+  int stop;
+  unsigned long generation;
+  int remaining;
+  acos_batch_fn batch;
+  float *out;
+  const float *in;
+  size_t n;
+};
+
+static struct acos_pool acos_pool = {
+  .call = PTHREAD_MUTEX_INITIALIZER,
+  .lock = PTHREAD_MUTEX_INITIALIZER,
+  .start = PTHREAD_COND_INITIALIZER,
+  .done = PTHREAD_COND_INITIALIZER,
+};
+
+static size_t acos_pool_min = ACOS_PARALLEL_THRESHOLD;
+
+/// First element of participant k's range: the even split point moved down to the
+/// start of its cache line in `out`.
+static size_t acos_pool_split(const float *out, size_t n, int parts, int k)
+{
+  if (k == 0) return 0;
+  if (k == parts) return n;
+  size_t raw = (size_t)((unsigned __int128)n * k / parts);
+  size_t into_line = ((uintptr_t)(out + raw) & 63) / sizeof(float);
+  return (raw > into_line) ? raw - into_line : 0;
+}
+
+static void acos_pool_run(struct acos_pool *p, int k)
+{
+  size_t lo = acos_pool_split(p->out, p->n, p->size, k);
+  size_t hi = acos_pool_split(p->out, p->n, p->size, k + 1);
+  if (hi > lo) p->batch(p->out + lo, p->in + lo, hi - lo);
+}
+
+static void *acos_pool_worker(void *arg)
+{
+  struct acos_pool *p = &acos_pool;
+  int k = (int)(intptr_t)arg;
+  unsigned long seen = 0;
+  pthread_mutex_lock(&p->lock);
+  for (;;) {
+    while (!p->stop && p->generation == seen) pthread_cond_wait(&p->start, &p->lock);
+    if (p->stop) break;
+    seen = p->generation;
+    pthread_mutex_unlock(&p->lock);
+    acos_pool_run(p, k);
+    pthread_mutex_lock(&p->lock);
+    if (--p->remaining == 0) pthread_cond_signal(&p->done);
+  }
+  pthread_mutex_unlock(&p->lock);
+  return NULL;
+}
+
+static void acos_pool_stop(struct acos_pool *p)
+{
+  if (p->size == 0) return;
+  pthread_mutex_lock(&p->lock);
+  p->stop = 1;
+  pthread_cond_broadcast(&p->start);
+  pthread_mutex_unlock(&p->lock);
+  for (int k = 1; k < p->size; k++) pthread_join(p->threads[k - 1], NULL);
+  free(p->threads);
+  p->threads = NULL;
+  p->size = 0;
+  p->stop = 0;
+}
+
+static int acos_pool_start(struct acos_pool *p, int threads)
+{
+  if (threads <= 0) threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+  if (threads < 1) threads = 1;
+  p->threads = calloc(threads, sizeof(pthread_t));
+  if (p->threads == NULL) return -1;
+  p->size = 1;
+  p->generation = 0;  // new workers wait for generation 1
+  for (int k = 1; k < threads; k++) {
+    if (pthread_create(&p->threads[k - 1], NULL, acos_pool_worker, (void *)(intptr_t)k) != 0) break;
+    p->size++;
+  }
+  return (threads > 1 && p->size == 1) ? -1 : p->size;
+}
+
+int acos_pool_init(int threads)
+{
+  pthread_mutex_lock(&acos_pool.call);
+  acos_pool_stop(&acos_pool);
+  int ret = acos_pool_start(&acos_pool, threads);
+  pthread_mutex_unlock(&acos_pool.call);
+  return ret;
+}
+
+void acos_pool_shutdown(void)
+{
+  pthread_mutex_lock(&acos_pool.call);
+  acos_pool_stop(&acos_pool);
+  pthread_mutex_unlock(&acos_pool.call);
+}
+
+int acos_pool_size(void)
+{
+  return acos_pool.size;
+}
+
+void acos_pool_threshold(size_t n)
+{
+  acos_pool_min = n;
+}
+
+void acos_parallel(acos_batch_fn batch, float *out, const float *in, size_t n)
+{
+  struct acos_pool *p = &acos_pool;
+  if (n < acos_pool_min) {
+    batch(out, in, n);
+    return;
+  }
+
+  pthread_mutex_lock(&p->call);
+  if (p->size == 0) acos_pool_start(p, 0);
+  if (p->size <= 1) {
+    pthread_mutex_unlock(&p->call);
+    batch(out, in, n);
+    return;
+  }
+
+  pthread_mutex_lock(&p->lock);
+  p->batch = batch;
+  p->out = out;
+  p->in = in;
+  p->n = n;
+  p->remaining = p->size - 1;
+  p->generation++;
+  pthread_cond_broadcast(&p->start);
+  pthread_mutex_unlock(&p->lock);
+
+  acos_pool_run(p, 0);
+
+  pthread_mutex_lock(&p->lock);
+  while (p->remaining > 0) pthread_cond_wait(&p->done, &p->lock);
+  pthread_mutex_unlock(&p->lock);
+  pthread_mutex_unlock(&p->call);
+}
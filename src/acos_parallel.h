@@ -0,0 +1,40 @@
+#ifndef __ACOS_PARALLEL_H
+#define __ACOS_PARALLEL_H
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <unistd.h>
+#include <pthread.h>
+
+/// Arrays shorter than this (in elements) are processed inline on the calling thread,
+/// where waking the pool would cost more than it saves. About 1 MiB of input.
+#define ACOS_PARALLEL_THRESHOLD (1 << 18)
+
+/// A batch kernel, e.g. acos_nvidia_v or the `batch` member of an acos_handle.
+typedef void (*acos_batch_fn)(float *out, const float *in, size_t n);
+
+/// Starts (or restarts) the pool with `threads` participants, counting the calling
+/// thread; threads <= 0 means one per online CPU. Workers persist across calls and
+/// sleep between them. Returns the pool size, or -1 if no worker could be started.
+/// Calling it is optional: acos_parallel starts a default pool on first use.
+int acos_pool_init(int threads);
+
+/// Stops and joins the workers. The next acos_parallel call starts a default pool.
+void acos_pool_shutdown(void);
+
+/// Number of participants in the current pool (0 before it is started).
+int acos_pool_size(void);
+
+/// Sets the inline-path threshold, in elements (ACOS_PARALLEL_THRESHOLD by default).
+/// 0 sends every call through the pool, which is what the scaling benchmark measures.
+void acos_pool_threshold(size_t n);
+
+/// out[i] = batch(in[i]) for i in [0, n), split across the pool.
+///
+/// The array is cut into one contiguous range per participant, with every boundary
+/// on a 64-byte line of `out`, so no two threads ever write to the same cache line.
+/// The calling thread takes the first range and returns once all ranges are done.
+/// Concurrent calls from different threads are serialized.
+void acos_parallel(acos_batch_fn batch, float *out, const float *in, size_t n);
+
+#endif
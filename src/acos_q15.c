@@ -0,0 +1,116 @@
+#include "acos_q15.h"
+
+// acos_nvidia5's coefficients in Q15 (c0 needs 17 bits and is only added in int32),
+// and π in Q13.
+#define ACOS_Q15_C3 (-614)
+#define ACOS_Q15_C2 2433
+#define ACOS_Q15_C1 (-6951)
+#define ACOS_Q15_C0 51471
+#define ACOS_Q13_PI 25736
+
+/// pmulhrsw on one lane: the Q15 product of a and b, rounded.
+static inline int32_t acos_q15_mulhrs(int32_t a, int32_t b)
+{
+  return (a * b + 0x4000) >> 15;
+}
+
+// Every intermediate fits in int16 up to the last Horner product, so the scalar kernel
+// computing in int32 matches the 16-bit lanes exactly. |x| is 2^15 for x = -1, which
+// pmulhrsw cannot take, so the polynomial sees it clamped to 2^15 - 1; sqrt(1 - |x|)
+// uses the exact value. y * 2^-19 = (1 - |x|) / 16 is exact, so its square root is
+// sqrt(1 - |x|) / 4 correctly rounded, and p (Q15) times that is r in Q13.
+int16_t acos_q15(int16_t x)
+{
+  int32_t a = abs(x);
+  int32_t ac = (a < 32767) ? a : 32767;
+  int32_t p = acos_q15_mulhrs(ACOS_Q15_C3, ac) + ACOS_Q15_C2;
+  p = acos_q15_mulhrs(p, ac) + ACOS_Q15_C1;
+  p = acos_q15_mulhrs(p, ac) + ACOS_Q15_C0;
+  float s = _mm_cvtss_f32(_mm_sqrt_ss(_mm_set_ss((float)(ACOS_Q15_ONE - a) * 0x1p-19f)));
+  int32_t r = _mm_cvtss_si32(_mm_set_ss((float)p * s));
+  int32_t neg = x >> 15;
+  return (int16_t)(((r ^ neg) - neg) + (neg & ACOS_Q13_PI));
+}
+
+// One vector of lanes per tier. ACOS_Q15_OP names the width's intrinsics; the few whose
+// suffix also changes with the width are spelled out.
+#if defined(__AVX512BW__)
+#define ACOS_Q15_LANES 32
+#define ACOS_Q15_OP(op) _mm512_##op
+#define ACOS_Q15_XOR _mm512_xor_si512
+#define ACOS_Q15_AND _mm512_and_si512
+#define ACOS_Q15_ZERO _mm512_setzero_si512
+#define ACOS_Q15_LOAD(p) _mm512_loadu_si512((const void *)(p))
+#define ACOS_Q15_STORE(p, v) _mm512_storeu_si512((void *)(p), v)
+typedef __m512i acos_q15_vi;
+typedef __m512 acos_q15_vf;
+#elif defined(__AVX2__)
+#define ACOS_Q15_LANES 16
+#define ACOS_Q15_OP(op) _mm256_##op
+#define ACOS_Q15_XOR _mm256_xor_si256
+#define ACOS_Q15_AND _mm256_and_si256
+#define ACOS_Q15_ZERO _mm256_setzero_si256
+#define ACOS_Q15_LOAD(p) _mm256_loadu_si256((const __m256i *)(p))
+#define ACOS_Q15_STORE(p, v) _mm256_storeu_si256((__m256i *)(p), v)
+typedef __m256i acos_q15_vi;
+typedef __m256 acos_q15_vf;
+#elif defined(__SSE4_1__)
+#define ACOS_Q15_LANES 8
+#define ACOS_Q15_OP(op) _mm_##op
+#define ACOS_Q15_XOR _mm_xor_si128
+#define ACOS_Q15_AND _mm_and_si128
+#define ACOS_Q15_ZERO _mm_setzero_si128
+#define ACOS_Q15_LOAD(p) _mm_loadu_si128((const __m128i *)(p))
+#define ACOS_Q15_STORE(p, v) _mm_storeu_si128((__m128i *)(p), v)
+typedef __m128i acos_q15_vi;
+typedef __m128 acos_q15_vf;
+#endif
+
+#ifdef ACOS_Q15_LANES
+
+/// Converts lanes of 32-bit p and y to r = p * sqrt(y * 2^-19) in Q13, as in acos_q15.
+static inline acos_q15_vi acos_q15_product(acos_q15_vi p, acos_q15_vi y)
+{
+  acos_q15_vf s = ACOS_Q15_OP(sqrt_ps)(ACOS_Q15_OP(mul_ps)(ACOS_Q15_OP(cvtepi32_ps)(y),
+                                                             ACOS_Q15_OP(set1_ps)(0x1p-19f)));
+  return ACOS_Q15_OP(cvtps_epi32)(ACOS_Q15_OP(mul_ps)(ACOS_Q15_OP(cvtepi32_ps)(p), s));
+}
+
+/// acos_q15 on every lane. The last Horner product and y = 1 - |x| are widened to int32
+/// with in-lane unpacks, which packs undoes in the same order.
+static inline acos_q15_vi acos_q15_vec(acos_q15_vi x)
+{
+  const acos_q15_vi zero = ACOS_Q15_ZERO();
+  acos_q15_vi a = ACOS_Q15_OP(abs_epi16)(x);  // -2^15 stays 0x8000, i.e. 2^15 unsigned
+  acos_q15_vi ac = ACOS_Q15_OP(min_epu16)(a, ACOS_Q15_OP(set1_epi16)(32767));
+  acos_q15_vi p = ACOS_Q15_OP(add_epi16)(
+    ACOS_Q15_OP(mulhrs_epi16)(ACOS_Q15_OP(set1_epi16)(ACOS_Q15_C3), ac),
+    ACOS_Q15_OP(set1_epi16)(ACOS_Q15_C2));
+  p = ACOS_Q15_OP(add_epi16)(ACOS_Q15_OP(mulhrs_epi16)(p, ac), ACOS_Q15_OP(set1_epi16)(ACOS_Q15_C1));
+  p = ACOS_Q15_OP(mulhrs_epi16)(p, ac);
+
+  acos_q15_vi psign = ACOS_Q15_OP(srai_epi16)(p, 15);
+  acos_q15_vi c0 = ACOS_Q15_OP(set1_epi32)(ACOS_Q15_C0);
+  acos_q15_vi plo = ACOS_Q15_OP(add_epi32)(ACOS_Q15_OP(unpacklo_epi16)(p, psign), c0);
+  acos_q15_vi phi = ACOS_Q15_OP(add_epi32)(ACOS_Q15_OP(unpackhi_epi16)(p, psign), c0);
+  acos_q15_vi y = ACOS_Q15_OP(sub_epi16)(ACOS_Q15_OP(set1_epi16)((short)0x8000), a);
+  acos_q15_vi ylo = ACOS_Q15_OP(unpacklo_epi16)(y, zero);
+  acos_q15_vi yhi = ACOS_Q15_OP(unpackhi_epi16)(y, zero);
+  acos_q15_vi r = ACOS_Q15_OP(packs_epi32)(acos_q15_product(plo, ylo), acos_q15_product(phi, yhi));
+
+  acos_q15_vi neg = ACOS_Q15_OP(srai_epi16)(x, 15);
+  r = ACOS_Q15_OP(sub_epi16)(ACOS_Q15_XOR(r, neg), neg);
+  return ACOS_Q15_OP(add_epi16)(r, ACOS_Q15_AND(neg, ACOS_Q15_OP(set1_epi16)(ACOS_Q13_PI)));
+}
+
+#endif
+
+void acos_q15_v(int16_t *out, const int16_t *in, size_t n)
+{
+  size_t i = 0;
+#ifdef ACOS_Q15_LANES
+  for (; i + ACOS_Q15_LANES <= n; i += ACOS_Q15_LANES)
+    ACOS_Q15_STORE(out + i, acos_q15_vec(ACOS_Q15_LOAD(in + i)));
+#endif
+  for (; i < n; i++) out[i] = acos_q15(in[i]);
+}
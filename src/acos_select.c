@@ -0,0 +1,68 @@
+#include "acos_select.h"
+
+/// One candidate for acos_select. Kernels are referenced by their slot in
+/// struct acos_kernels so a handle picks up the tier selected at load time.
+struct acos_select_entry {
+  const char *name;
+  float max_abs_err;  // acos-approx -e, every float in [-1, 1]
+  float cost;         // acos-bench -m latency, avx2 tier, TSC ticks per call
+  size_t scalar;      // offsetof(struct acos_kernels, ...)
+  size_t batch;
+};
+
+static void acos_libm_v(float *out, const float *in, size_t n)
+{
+  for (size_t i = 0; i < n; i++) out[i] = acosf(in[i]);
+}
+
+#define ACOS_SELECT_ENTRY(name, scalar, batch, err, cost) \
+  { name, err, cost, offsetof(struct acos_kernels, scalar), offsetof(struct acos_kernels, batch) }
+
+// Sorted by cost, and each row strictly more accurate than the one before it:
+// acos_select returns the first row that fits, so a row that is no more accurate than a
+// cheaper one could never be returned. Measured on a Xeon with AVX-512. The batch
+// kernels are all bound by packed sqrt throughput (about 0.6 ticks/element at every
+// degree), so the latency of the scalar form is what separates the candidates.
+// acos_nvidia7 has no batch form of its own; acos_nvidia_v evaluates the same
+// polynomial to the same maximum error.
+//
+// acos_nvidia6 (6.77e-5 at 21.5 ticks) and acos_minimax2 (3.26e-4 at 20.9) are left
+// out: acos_nvidia7 is cheaper and at least as accurate as both.
+//
+// acos_binomial_rr is left out: it is cheap in throughput (about 13 ticks), but its
+// ten-term Horner chain follows the square root, so in latency it loses to
+// acos_minimax7 on both axes (3.62e-7 at 59.1 ticks).
+//
+// acos_lut_linear and acos_lut_cubic are left out on purpose. Their error is fixed by
+// LUT_BITS at build time, so it cannot be one row of this table. They also lose at every
+// size measured, even with the table warm in L1: 2.0e-6 at 38.0 ticks (linear, 8 bits)
+// against acos_minimax5, and 4.0e-7 at 46.1 (cubic) against acos_minimax7. A cold table
+// only adds cache misses to that.
+static const struct acos_select_entry acos_select_table[] = {
+  ACOS_SELECT_ENTRY("acos_nvidia7",  acos_nvidia7,  acos_nvidia_v,   6.7725e-05f, 15.5f),
+  ACOS_SELECT_ENTRY("acos_minimax3", acos_minimax3, acos_minimax3_v, 3.8286e-05f, 22.0f),
+  ACOS_SELECT_ENTRY("acos_minimax4", acos_minimax4, acos_minimax4_v, 5.1016e-06f, 22.5f),
+  ACOS_SELECT_ENTRY("acos_minimax5", acos_minimax5, acos_minimax5_v, 9.7358e-07f, 25.4f),
+  ACOS_SELECT_ENTRY("acos_minimax6", acos_minimax6, acos_minimax6_v, 4.4253e-07f, 27.4f),
+  ACOS_SELECT_ENTRY("acos_minimax7", acos_minimax7, acos_minimax7_v, 3.5284e-07f, 30.3f),
+};
+
+#define ACOS_SELECT_COUNT (sizeof(acos_select_table) / sizeof(acos_select_table[0]))
+
+// libm acosf: 2.1410e-07 max abs error, 54.4 ticks per call.
+#define ACOS_LIBM_ERR 2.1410e-07f
+
+struct acos_handle acos_select(float max_abs_err)
+{
+  for (size_t i = 0; i < ACOS_SELECT_COUNT; i++) {
+    const struct acos_select_entry *e = &acos_select_table[i];
+    if (e->max_abs_err <= max_abs_err) {
+      const char *k = (const char *)acos_dispatch;
+      struct acos_handle h = { e->name, e->max_abs_err, NULL, NULL };
+      h.scalar = *(float (*const *)(float))(k + e->scalar);
+      h.batch = *(void (*const *)(float *, const float *, size_t))(k + e->batch);
+      return h;
+    }
+  }
+  return (struct acos_handle){ "acosf", ACOS_LIBM_ERR, acosf, acos_libm_v };
+}
@@ -0,0 +1,27 @@
+#ifndef __ACOS_SELECT_H
+#define __ACOS_SELECT_H
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <math.h>
+
+#include "acos_dispatch.h"
+
+/// Pass as `max_abs_err` to acos_select to require libm `acosf`.
+#define ACOS_FLOAT_PRECISION 0.0f
+
+/// A kernel chosen once for an error budget. Call through `scalar` or `batch` in the
+/// hot loop; neither pointer is re-evaluated per call.
+struct acos_handle {
+  const char *name;
+  float max_abs_err;  // measured over every float in [-1, 1] (acos-approx -e)
+  float (*scalar)(float x);
+  void (*batch)(float *out, const float *in, size_t n);
+};
+
+/// Returns the cheapest kernel whose measured maximum absolute error is at most
+/// `max_abs_err`, built for the ISA tier acos_dispatch currently points at.
+/// Falls back to libm `acosf` when no approximation is accurate enough.
+struct acos_handle acos_select(float max_abs_err);
+
+#endif
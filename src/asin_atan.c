@@ -0,0 +1,168 @@
+#include "asin_atan.h"
+
+// GCC vectors of one float and of the widest lanes this tier has. The kernels are
+// written once, with plain operators and integer masks, and instantiated for both, as
+// in acos_double.c, so scalar and batch results match exactly.
+#if defined(__AVX512F__)
+#define ASIN_ATAN_VBYTES 64
+#elif defined(__AVX__)
+#define ASIN_ATAN_VBYTES 32
+#else
+#define ASIN_ATAN_VBYTES 16
+#endif
+#define ASIN_ATAN_VLANES (ASIN_ATAN_VBYTES / (int)sizeof(float))
+typedef float asin_atan_f1 __attribute__((vector_size(sizeof(float))));
+typedef int asin_atan_i1 __attribute__((vector_size(sizeof(float))));
+typedef float asin_atan_vf __attribute__((vector_size(ASIN_ATAN_VBYTES)));
+typedef int asin_atan_vi __attribute__((vector_size(ASIN_ATAN_VBYTES)));
+
+#define ASIN_ATAN_PIO2 1.57079632679489662f
+
+static inline asin_atan_f1 asin_atan_sqrt1(asin_atan_f1 v)
+{
+  return (asin_atan_f1){ _mm_cvtss_f32(_mm_sqrt_ss(_mm_set_ss(v[0]))) };
+}
+
+static inline asin_atan_vf asin_atan_sqrtv(asin_atan_vf v)
+{
+#if defined(__AVX512F__)
+  return (asin_atan_vf)_mm512_sqrt_ps((__m512)v);
+#elif defined(__AVX__)
+  return (asin_atan_vf)_mm256_sqrt_ps((__m256)v);
+#else
+  return (asin_atan_vf)_mm_sqrt_ps((__m128)v);
+#endif
+}
+
+// Empty asm that makes GCC materialize v, so that no multiply feeding it is contracted
+// into a later add. The one-float vector does not fit an "x" operand; its float does.
+static inline asin_atan_f1 asin_atan_round1(asin_atan_f1 v)
+{
+  float f = v[0];
+  __asm__("" : "+x"(f));
+  return (asin_atan_f1){ f };
+}
+
+static inline asin_atan_vf asin_atan_roundv(asin_atan_vf v)
+{
+  __asm__("" : "+x"(v));
+  return v;
+}
+
+// acos_nvidia6's polynomial, with the same Horner order so contraction matches.
+#define ASIN_ATAN_P(a) \
+  (((ACOS_NVIDIA_C3 * (a) + ACOS_NVIDIA_C2) * (a) + ACOS_NVIDIA_C1) * (a) + ACOS_NVIDIA_C0)
+
+// r = acos(|x|) is shared; acos folds it with acos_nvidia6's r + neg * (π - 2r) and
+// asin takes π/2 - r with x's sign bit. GCC only contracts p * sqrt into π/2 - r when
+// no other use needs the product, i.e. in asin alone, so r is rounded through vround in
+// every instantiation to keep asin_nvidia and the fused asin identical.
+#define ASIN_ATAN_CORE(sfx, vf, vi, vsqrt, vround)                                          \
+  static inline vf acos_asin_##sfx(vf x, vf *asin_x)                                \
+  {                                                                                 \
+    const vi sign = (vi){ 0 } + (int)0x80000000;                                    \
+    const vi one = (vi)((vf){ 0 } + 1.0f);                                          \
+    vf ax = (vf)((vi)x & ~sign);                                                    \
+    vf r = vround(ASIN_ATAN_P(ax) * vsqrt(1.0f - ax));                              \
+    vf neg = (vf)((x < 0.0f) & one);                                                \
+    *asin_x = (vf)((vi)(ASIN_ATAN_PIO2 - r) ^ ((vi)x & sign));                      \
+    return r + neg * (ACOS_NVIDIA_PI - 2.0f * r);                                   \
+  }                                                                                 \
+                                                                                    \
+  static inline vf atan2_##sfx(vf y, vf x)                                          \
+  {                                                                                 \
+    const vi sign = (vi){ 0 } + (int)0x80000000;                                    \
+    const vi one = (vi)((vf){ 0 } + 1.0f);                                          \
+    vf ax = (vf)((vi)x & ~sign);                                                    \
+    vf ay = (vf)((vi)y & ~sign);                                                    \
+    vi swap = (ay > ax);                                                            \
+    vf lo = (vf)((swap & (vi)ax) | (~swap & (vi)ay));                               \
+    vf hi = (vf)((swap & (vi)ay) | (~swap & (vi)ax));                               \
+    hi = (vf)((vi)hi | ((hi == 0.0f) & one));  /* 0 / 0 becomes 0 / 1 */            \
+    vf t = lo / hi;                                                                 \
+    vf u = 1.0f + t * t;                                                            \
+    vf q = vsqrt(u);                                                                \
+    vf phi = ASIN_ATAN_P(1.0f / q) * (t / vsqrt(u + q));                            \
+    phi = phi + (vf)(swap & one) * (ASIN_ATAN_PIO2 - 2.0f * phi);                   \
+    phi = phi + (vf)(((vi)x >> 31) & one) * (ACOS_NVIDIA_PI - 2.0f * phi);          \
+    return (vf)((vi)phi ^ ((vi)y & sign));                                          \
+  }
+
+ASIN_ATAN_CORE(f1, asin_atan_f1, asin_atan_i1, asin_atan_sqrt1, asin_atan_round1)
+ASIN_ATAN_CORE(vf, asin_atan_vf, asin_atan_vi, asin_atan_sqrtv, asin_atan_roundv)
+
+float acos_asin_nvidia(float x, float *asin_x)
+{
+  asin_atan_f1 s;
+  float r = acos_asin_f1((asin_atan_f1){ x }, &s)[0];
+  *asin_x = s[0];
+  return r;
+}
+
+float asin_nvidia(float x)
+{
+  asin_atan_f1 s;
+  acos_asin_f1((asin_atan_f1){ x }, &s);
+  return s[0];
+}
+
+float atan2_nvidia(float y, float x)
+{
+  return atan2_f1((asin_atan_f1){ y }, (asin_atan_f1){ x })[0];
+}
+
+float atan_nvidia(float x)
+{
+  return atan2_f1((asin_atan_f1){ x }, (asin_atan_f1){ 1.0f })[0];
+}
+
+void acos_asin_nvidia_v(float *acos_out, float *asin_out, const float *in, size_t n)
+{
+  size_t i = 0;
+  for (; i + ASIN_ATAN_VLANES <= n; i += ASIN_ATAN_VLANES) {
+    asin_atan_vf x, r, s;
+    memcpy(&x, in + i, sizeof(x));
+    r = acos_asin_vf(x, &s);
+    memcpy(acos_out + i, &r, sizeof(r));
+    memcpy(asin_out + i, &s, sizeof(s));
+  }
+  for (; i < n; i++) acos_out[i] = acos_asin_nvidia(in[i], &asin_out[i]);
+}
+
+void asin_nvidia_v(float *out, const float *in, size_t n)
+{
+  size_t i = 0;
+  for (; i + ASIN_ATAN_VLANES <= n; i += ASIN_ATAN_VLANES) {
+    asin_atan_vf x, s;
+    memcpy(&x, in + i, sizeof(x));
+    acos_asin_vf(x, &s);
+    memcpy(out + i, &s, sizeof(s));
+  }
+  for (; i < n; i++) out[i] = asin_nvidia(in[i]);
+}
+
+void atan2_nvidia_v(float *out, const float *y, const float *x, size_t n)
+{
+  size_t i = 0;
+  for (; i + ASIN_ATAN_VLANES <= n; i += ASIN_ATAN_VLANES) {
+    asin_atan_vf vy, vx, r;
+    memcpy(&vy, y + i, sizeof(vy));
+    memcpy(&vx, x + i, sizeof(vx));
+    r = atan2_vf(vy, vx);
+    memcpy(out + i, &r, sizeof(r));
+  }
+  for (; i < n; i++) out[i] = atan2_nvidia(y[i], x[i]);
+}
+
+void atan_nvidia_v(float *out, const float *in, size_t n)
+{
+  const asin_atan_vf one = (asin_atan_vf){ 0 } + 1.0f;
+  size_t i = 0;
+  for (; i + ASIN_ATAN_VLANES <= n; i += ASIN_ATAN_VLANES) {
+    asin_atan_vf x, r;
+    memcpy(&x, in + i, sizeof(x));
+    r = atan2_vf(x, one);
+    memcpy(out + i, &r, sizeof(r));
+  }
+  for (; i < n; i++) out[i] = atan_nvidia(in[i]);
+}
@@ -0,0 +1,48 @@
+#ifndef __ASIN_ATAN_H
+#define __ASIN_ATAN_H
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <immintrin.h>
+
+#include "acos_nvidia_simd.h"
+
+/// asin(x) from acos_nvidia6's core, as in NVIDIA's Cg reference asin:
+/// r = p(|x|) * sqrt(1 - |x|) is acos(|x|), so asin(x) = ±(π/2 - r) with the sign
+/// bit of x moved onto the result. Same maximum absolute error as acos_nvidia6
+/// (6.8e-5); the error is absolute, not relative, so asin(0) is 6.7e-5, not 0.
+float asin_nvidia(float x);
+
+/// acos_nvidia6(x) and asin_nvidia(x) from one evaluation of the polynomial and square
+/// root. Returns the acos and stores the asin in *asin_x; both are bitwise identical
+/// to the separate kernels.
+float acos_asin_nvidia(float x, float *asin_x);
+
+/// atan2(y, x) from acos_nvidia6's core. The angle is reduced to φ = atan(t) in
+/// [0, π/4] with t = min(|x|, |y|) / max(|x|, |y|), and φ = acos(c) with
+/// c = 1 / sqrt(1 + t^2). The core's sqrt(1 - c) is computed as
+/// t / sqrt((1 + t^2) + sqrt(1 + t^2)), which does not cancel, so small angles keep
+/// their relative accuracy and atan2(0, x > 0) is exactly 0. The octant is then
+/// restored in acos_nvidia6's style, φ + m * (k - 2φ) with 0/1 masks m for |y| > |x|
+/// (k = π/2) and for x's sign bit (k = π), and y's sign bit is copied onto the result.
+/// Nothing branches on the inputs.
+///
+/// Maximum absolute error is 2.9e-5, at most 803 ulps (acos-approx -e -a).
+/// atan2(±0, -0) is ±π like libm; atan2(±inf, ±inf) is NaN instead of an odd
+/// multiple of π/4.
+float atan2_nvidia(float y, float x);
+
+/// atan(x) = atan2_nvidia(x, 1).
+float atan_nvidia(float x);
+
+/// Batch forms: out[i] = asin(in[i]), atan(in[i]) or atan2(y[i], x[i]) for i in [0, n),
+/// and acos_out[i], asin_out[i] from in[i] for the fused form. They use the widest
+/// vectors of the tier and are bitwise identical to the scalar kernels. Outputs may be
+/// the same buffer as an input but must not otherwise overlap.
+void asin_nvidia_v(float *out, const float *in, size_t n);
+void atan_nvidia_v(float *out, const float *in, size_t n);
+void atan2_nvidia_v(float *out, const float *y, const float *x, size_t n);
+void acos_asin_nvidia_v(float *acos_out, float *asin_out, const float *in, size_t n);
+
+#endif
@@ -0,0 +1,822 @@
+#include "bench.h"
+
+#define BENCH_MAX_VARIANTS 256
+
+static struct bench_variant variants[BENCH_MAX_VARIANTS];
+static size_t variants_count = 0;
+static int binomial_rounds = 29;
+
+/// DESA variants read this signal instead of the shared input buffer, whose uniform
+/// noise would send most estimates (and acosf) down the NaN path, and write their
+/// amplitude estimates to bench_desa_amp.
+static float *bench_desa_signal;
+static float *bench_desa_amp;
+
+/// Double-precision variants run over bench_double_in, the shared inputs widened to
+/// double, into bench_double_out; the 16-bit-input variants read the shared inputs
+/// rounded to binary16 or bfloat16, and the Q15 variants read them rounded to Q15
+/// into bench_q15_out.
+static double *bench_double_in;
+static double *bench_double_out;
+static uint16_t *bench_f16_in;
+static uint16_t *bench_bf16_in;
+static int16_t *bench_q15_in;
+static int16_t *bench_q15_out;
+
+/// atan2 variants take the shared inputs as y and bench_atan2_x, the same inputs in
+/// reverse order, as x; the fused acos + asin variants write asin to bench_asin_out.
+static float *bench_atan2_x;
+static float *bench_asin_out;
+
+/// The counting clamp variants add their clamped and NaN inputs here.
+static struct acos_clamp_counts bench_clamp_counts;
+
+/// Planar DESA variants split the signal into this many bands of n / BENCH_DESA_BANDS
+/// samples each.
+#define BENCH_DESA_BANDS 16
+
+/// Keeps the compiler from proving `p` dead and discarding the stores behind it.
+static inline void bench_escape(void *p)
+{
+  __asm__ volatile("" : : "g"(p) : "memory");
+}
+
+/// Accumulates one element per repetition so results are observably used.
+static volatile float bench_sink;
+
+static double bench_now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+  return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static inline uint64_t bench_tsc(void)
+{
+  unsigned int aux;
+  return __rdtscp(&aux);
+}
+
+static void bench_run_scalar(const struct bench_variant *v, float *out, const float *in, size_t n)
+{
+  float (*f)(float) = v->fn.scalar;
+  for (size_t i = 0; i < n; i++) out[i] = f(in[i]);
+}
+
+static void bench_run_rounds(const struct bench_variant *v, float *out, const float *in, size_t n)
+{
+  float (*f)(float, int) = v->fn.rounds;
+  int rounds = binomial_rounds;
+  for (size_t i = 0; i < n; i++) out[i] = f(in[i], rounds);
+}
+
+static void bench_run_batch(const struct bench_variant *v, float *out, const float *in, size_t n)
+{
+  v->fn.batch(out, in, n);
+}
+
+static void bench_run_desa(const struct bench_variant *v, float *out, const float *in, size_t n)
+{
+  (void)in;
+  struct desa_state st;
+  desa_reset(&st);
+  v->fn.desa(&st, out, bench_desa_amp, bench_desa_signal, n);
+  bench_escape(bench_desa_amp);
+}
+
+static void bench_run_desa_planar(const struct bench_variant *v, float *out, const float *in, size_t n)
+{
+  (void)in;
+  struct desa_state st[BENCH_DESA_BANDS];
+  float *freq[BENCH_DESA_BANDS], *amp[BENCH_DESA_BANDS];
+  const float *sig[BENCH_DESA_BANDS];
+  size_t len = n / BENCH_DESA_BANDS;
+  for (int c = 0; c < BENCH_DESA_BANDS; c++) {
+    desa_reset(&st[c]);
+    freq[c] = out + c * len;
+    amp[c] = bench_desa_amp + c * len;
+    sig[c] = bench_desa_signal + c * len;
+  }
+  v->fn.desa_planar(st, freq, amp, sig, BENCH_DESA_BANDS, len);
+  bench_escape(bench_desa_amp);
+}
+
+static void bench_run_dscalar(const struct bench_variant *v, float *out, const float *in, size_t n)
+{
+  (void)out;
+  (void)in;
+  double (*f)(double) = v->fn.dscalar;
+  for (size_t i = 0; i < n; i++) bench_double_out[i] = f(bench_double_in[i]);
+  bench_escape(bench_double_out);
+}
+
+static void bench_run_dbatch(const struct bench_variant *v, float *out, const float *in, size_t n)
+{
+  (void)out;
+  (void)in;
+  v->fn.dbatch(bench_double_out, bench_double_in, n);
+  bench_escape(bench_double_out);
+}
+
+static void bench_run_f16(const struct bench_variant *v, float *out, const float *in, size_t n)
+{
+  (void)in;
+  v->fn.half(out, bench_f16_in, n);
+}
+
+static void bench_run_bf16(const struct bench_variant *v, float *out, const float *in, size_t n)
+{
+  (void)in;
+  v->fn.half(out, bench_bf16_in, n);
+}
+
+static void bench_run_qscalar(const struct bench_variant *v, float *out, const float *in, size_t n)
+{
+  (void)out;
+  (void)in;
+  int16_t (*f)(int16_t) = v->fn.qscalar;
+  for (size_t i = 0; i < n; i++) bench_q15_out[i] = f(bench_q15_in[i]);
+  bench_escape(bench_q15_out);
+}
+
+static void bench_run_qbatch(const struct bench_variant *v, float *out, const float *in, size_t n)
+{
+  (void)out;
+  (void)in;
+  v->fn.qbatch(bench_q15_out, bench_q15_in, n);
+  bench_escape(bench_q15_out);
+}
+
+static void bench_run_binary(const struct bench_variant *v, float *out, const float *in, size_t n)
+{
+  float (*f)(float, float) = v->fn.binary;
+  for (size_t i = 0; i < n; i++) out[i] = f(in[i], bench_atan2_x[i]);
+}
+
+static void bench_run_batch2(const struct bench_variant *v, float *out, const float *in, size_t n)
+{
+  v->fn.batch2(out, in, bench_atan2_x, n);
+}
+
+static void bench_run_fused(const struct bench_variant *v, float *out, const float *in, size_t n)
+{
+  float (*f)(float, float *) = v->fn.fused;
+  for (size_t i = 0; i < n; i++) out[i] = f(in[i], &bench_asin_out[i]);
+  bench_escape(bench_asin_out);
+}
+
+static void bench_run_fbatch(const struct bench_variant *v, float *out, const float *in, size_t n)
+{
+  v->fn.fbatch(out, bench_asin_out, in, n);
+  bench_escape(bench_asin_out);
+}
+
+static void bench_run_counted(const struct bench_variant *v, float *out, const float *in, size_t n)
+{
+  v->fn.counted(out, in, n, &bench_clamp_counts);
+}
+
+// `y * 0.0f` cannot be folded without -ffast-math (y may be NaN, Inf or -0), so the
+// next input waits for the previous result while staying equal to in[i].
+static void bench_chain_scalar(const struct bench_variant *v, float *out, const float *in, size_t n)
+{
+  float (*f)(float) = v->fn.scalar;
+  float y = 0.0f;
+  for (size_t i = 0; i < n; i++) out[i] = y = f(in[i] + y * 0.0f);
+}
+
+static void bench_chain_rounds(const struct bench_variant *v, float *out, const float *in, size_t n)
+{
+  float (*f)(float, int) = v->fn.rounds;
+  int rounds = binomial_rounds;
+  float y = 0.0f;
+  for (size_t i = 0; i < n; i++) out[i] = y = f(in[i] + y * 0.0f, rounds);
+}
+
+static void bench_chain_dscalar(const struct bench_variant *v, float *out, const float *in, size_t n)
+{
+  (void)out;
+  (void)in;
+  double (*f)(double) = v->fn.dscalar;
+  double y = 0.0;
+  for (size_t i = 0; i < n; i++) bench_double_out[i] = y = f(bench_double_in[i] + y * 0.0);
+  bench_escape(bench_double_out);
+}
+
+// The Q13 result is at most 25736, so `y & 0` chains without changing the input.
+static void bench_chain_qscalar(const struct bench_variant *v, float *out, const float *in, size_t n)
+{
+  (void)out;
+  (void)in;
+  int16_t (*f)(int16_t) = v->fn.qscalar;
+  int16_t y = 0;
+  for (size_t i = 0; i < n; i++) {
+    int16_t zero = 0;
+    __asm__("" : "+r"(zero));
+    bench_q15_out[i] = y = f((int16_t)(bench_q15_in[i] + (y & zero)));
+  }
+  bench_escape(bench_q15_out);
+}
+
+static void bench_chain_binary(const struct bench_variant *v, float *out, const float *in, size_t n)
+{
+  float (*f)(float, float) = v->fn.binary;
+  float y = 0.0f;
+  for (size_t i = 0; i < n; i++) out[i] = y = f(in[i] + y * 0.0f, bench_atan2_x[i]);
+}
+
+// Only the acos result is chained; the asin store is off the dependency path.
+static void bench_chain_fused(const struct bench_variant *v, float *out, const float *in, size_t n)
+{
+  float (*f)(float, float *) = v->fn.fused;
+  float y = 0.0f;
+  for (size_t i = 0; i < n; i++) out[i] = y = f(in[i] + y * 0.0f, &bench_asin_out[i]);
+  bench_escape(bench_asin_out);
+}
+
+/// Reference for latency mode: the cost of the call and the chaining arithmetic alone.
+static float bench_identity(float x)
+{
+  return x;
+}
+
+static struct bench_variant *bench_add(const char *name, const char *isa)
+{
+  if (variants_count == BENCH_MAX_VARIANTS) {
+    fprintf(stderr, "Too many benchmark variants; raise BENCH_MAX_VARIANTS.\n");
+    exit(-1);
+  }
+  struct bench_variant *v = &variants[variants_count++];
+  snprintf(v->name, sizeof(v->name), "%s", name);
+  v->isa = isa;
+  v->chain = NULL;
+  return v;
+}
+
+static void bench_add_scalar(const char *name, const char *isa, float (*f)(float))
+{
+  struct bench_variant *v = bench_add(name, isa);
+  v->run = bench_run_scalar;
+  v->chain = bench_chain_scalar;
+  v->fn.scalar = f;
+}
+
+static void bench_add_rounds(const char *name, const char *isa, float (*f)(float, int))
+{
+  struct bench_variant *v = bench_add(name, isa);
+  v->run = bench_run_rounds;
+  v->chain = bench_chain_rounds;
+  v->fn.rounds = f;
+}
+
+static void bench_add_batch(const char *name, const char *isa, void (*f)(float *, const float *, size_t))
+{
+  struct bench_variant *v = bench_add(name, isa);
+  v->run = bench_run_batch;
+  v->fn.batch = f;
+}
+
+static void bench_add_desa(const char *name, const char *isa,
+                           size_t (*f)(struct desa_state *, float *, float *, const float *, size_t))
+{
+  struct bench_variant *v = bench_add(name, isa);
+  v->run = bench_run_desa;
+  v->fn.desa = f;
+}
+
+static void bench_add_desa_planar(const char *name, const char *isa,
+                                  size_t (*f)(struct desa_state *, float *const *, float *const *,
+                                              const float *const *, size_t, size_t))
+{
+  struct bench_variant *v = bench_add(name, isa);
+  v->run = bench_run_desa_planar;
+  v->fn.desa_planar = f;
+}
+
+static void bench_add_dscalar(const char *name, const char *isa, double (*f)(double))
+{
+  struct bench_variant *v = bench_add(name, isa);
+  v->run = bench_run_dscalar;
+  v->chain = bench_chain_dscalar;
+  v->fn.dscalar = f;
+}
+
+static void bench_add_dbatch(const char *name, const char *isa, void (*f)(double *, const double *, size_t))
+{
+  struct bench_variant *v = bench_add(name, isa);
+  v->run = bench_run_dbatch;
+  v->fn.dbatch = f;
+}
+
+static void bench_add_qscalar(const char *name, const char *isa, int16_t (*f)(int16_t))
+{
+  struct bench_variant *v = bench_add(name, isa);
+  v->run = bench_run_qscalar;
+  v->chain = bench_chain_qscalar;
+  v->fn.qscalar = f;
+}
+
+static void bench_add_qbatch(const char *name, const char *isa, void (*f)(int16_t *, const int16_t *, size_t))
+{
+  struct bench_variant *v = bench_add(name, isa);
+  v->run = bench_run_qbatch;
+  v->fn.qbatch = f;
+}
+
+static void bench_add_binary(const char *name, const char *isa, float (*f)(float, float))
+{
+  struct bench_variant *v = bench_add(name, isa);
+  v->run = bench_run_binary;
+  v->chain = bench_chain_binary;
+  v->fn.binary = f;
+}
+
+static void bench_add_batch2(const char *name, const char *isa,
+                             void (*f)(float *, const float *, const float *, size_t))
+{
+  struct bench_variant *v = bench_add(name, isa);
+  v->run = bench_run_batch2;
+  v->fn.batch2 = f;
+}
+
+static void bench_add_fused(const char *name, const char *isa, float (*f)(float, float *))
+{
+  struct bench_variant *v = bench_add(name, isa);
+  v->run = bench_run_fused;
+  v->chain = bench_chain_fused;
+  v->fn.fused = f;
+}
+
+static void bench_add_fbatch(const char *name, const char *isa,
+                             void (*f)(float *, float *, const float *, size_t))
+{
+  struct bench_variant *v = bench_add(name, isa);
+  v->run = bench_run_fbatch;
+  v->fn.fbatch = f;
+}
+
+static void bench_add_counted(const char *name, const char *isa,
+                              void (*f)(float *, const float *, size_t, struct acos_clamp_counts *))
+{
+  struct bench_variant *v = bench_add(name, isa);
+  v->run = bench_run_counted;
+  v->fn.counted = f;
+}
+
+/// binary16 and bfloat16 kernels share a signature; the name says which input to feed.
+static void bench_add_half(const char *name, const char *isa, void (*f)(float *, const uint16_t *, size_t))
+{
+  struct bench_variant *v = bench_add(name, isa);
+  v->run = (strstr(name, "bf16") != NULL) ? bench_run_bf16 : bench_run_f16;
+  v->fn.half = f;
+}
+
+/// Registers a tier's build of one kernel, picking the runner from its signature.
+#define BENCH_ADD_KERNEL(k, ret, fn, params, args)                   \
+  _Generic((k)->fn,                                                  \
+           float (*)(float): bench_add_scalar,                       \
+           float (*)(float, int): bench_add_rounds,                  \
+           void (*)(float *, const float *, size_t): bench_add_batch, \
+           size_t (*)(struct desa_state *, float *, float *, const float *, size_t): bench_add_desa, \
+           size_t (*)(struct desa_state *, float *const *, float *const *,   \
+                      const float *const *, size_t, size_t): bench_add_desa_planar, \
+           double (*)(double): bench_add_dscalar,                    \
+           void (*)(double *, const double *, size_t): bench_add_dbatch, \
+           void (*)(float *, const uint16_t *, size_t): bench_add_half, \
+           int16_t (*)(int16_t): bench_add_qscalar,                  \
+           void (*)(int16_t *, const int16_t *, size_t): bench_add_qbatch, \
+           float (*)(float, float): bench_add_binary,                \
+           void (*)(float *, const float *, const float *, size_t): bench_add_batch2, \
+           float (*)(float, float *): bench_add_fused,               \
+           void (*)(float *, float *, const float *, size_t): bench_add_fbatch, \
+           void (*)(float *, const float *, size_t, struct acos_clamp_counts *): bench_add_counted \
+    )(#fn, acos_isa_name((k)->isa), (k)->fn);
+
+/// Registers the libm references and every tier's kernels up to `top`.
+static void bench_register(enum acos_isa top)
+{
+  bench_add_scalar("acosf", "libm", acosf);
+  bench_add_dscalar("acos", "libm", acos);
+  bench_add_scalar("asinf", "libm", asinf);
+  bench_add_scalar("atanf", "libm", atanf);
+  bench_add_binary("atan2f", "libm", atan2f);
+  for (int isa = 0; isa <= (int)top; isa++) {
+    const struct acos_kernels *k = acos_isa_kernels(isa);
+    ACOS_SCALAR_KERNELS(BENCH_ADD_KERNEL, k)
+    ACOS_BATCH_KERNELS(BENCH_ADD_KERNEL, k)
+    ACOS_DESA_KERNELS(BENCH_ADD_KERNEL, k)
+    ACOS_PRECISION_SCALAR_KERNELS(BENCH_ADD_KERNEL, k)
+    ACOS_PRECISION_BATCH_KERNELS(BENCH_ADD_KERNEL, k)
+    ACOS_TRIG_SCALAR_KERNELS(BENCH_ADD_KERNEL, k)
+    ACOS_TRIG_BATCH_KERNELS(BENCH_ADD_KERNEL, k)
+    ACOS_COUNTED_BATCH_KERNELS(BENCH_ADD_KERNEL, k)
+  }
+}
+
+static int bench_cmp(const void *a, const void *b)
+{
+  double x = *(const double *)a;
+  double y = *(const double *)b;
+  return (x > y) - (x < y);
+}
+
+static void bench_summarize(double *samples, int count, struct bench_stats *s)
+{
+  qsort(samples, count, sizeof(double), bench_cmp);
+  s->min = samples[0];
+  s->max = samples[count - 1];
+  s->median = samples[count / 2];
+  s->iqr = samples[(3 * count) / 4] - samples[count / 4];
+}
+
+/// Times `run` over the buffers. Each repetition runs it `iters` times back to back and
+/// records ns and TSC ticks per element; nothing but the variant runs inside the timed
+/// region.
+static void bench_measure(const struct bench_variant *v,
+                          void (*run)(const struct bench_variant *, float *, const float *, size_t),
+                          float *out, const float *in, size_t n,
+                          int reps, int warmup, double target_ns, struct bench_result *res)
+{
+  double ns[reps];
+  double tsc[reps];
+
+  for (int w = 0; w < warmup; w++) {
+    run(v, out, in, n);
+    bench_escape(out);
+  }
+
+  // Calibrate the inner repeat count so each repetition lasts about target_ns.
+  double t0 = bench_now();
+  run(v, out, in, n);
+  bench_escape(out);
+  double once = bench_now() - t0;
+  long iters = (once > 0.0) ? (long)(target_ns / once) : 1;
+  if (iters < 1) iters = 1;
+
+  for (int r = 0; r < reps; r++) {
+    t0 = bench_now();
+    uint64_t c0 = bench_tsc();
+    for (long it = 0; it < iters; it++) {
+      run(v, out, in, n);
+      bench_escape(out);
+    }
+    uint64_t c1 = bench_tsc();
+    double t1 = bench_now();
+    ns[r] = (t1 - t0) / ((double)iters * n);
+    tsc[r] = (double)(c1 - c0) / ((double)iters * n);
+    bench_sink += out[r % n];
+  }
+  bench_summarize(ns, reps, &res->ns);
+  bench_summarize(tsc, reps, &res->tsc);
+  res->iters = iters;
+}
+
+/// Counts hardware events over one more calibrated repetition of the throughput runner
+/// and prints them per element, as an aligned table or as CSV. Events the host does
+/// not provide are shown as "-" (empty in CSV).
+static void bench_counters(struct perfctr *pc, enum bench_perf format, const char *filter,
+                           float *out, const float *in, size_t n, int reps, int warmup,
+                           double target_ns)
+{
+  const char *cycles = perfctr_name(PERFCTR_CYCLES);
+  const char *instructions = perfctr_name(PERFCTR_INSTRUCTIONS);
+  const char *branch_misses = perfctr_name(PERFCTR_BRANCH_MISSES);
+  const char *l1d_misses = perfctr_name(PERFCTR_L1D_MISSES);
+  if (format == BENCH_PERF_CSV)
+    fprintf(stdout, "variant,isa,tsc,%s,%s,ipc,%s,%s\n", cycles, instructions, branch_misses,
+            l1d_misses);
+  else
+    fprintf(stdout, "%-18s %-9s %9s %9s %12s %7s %13s %10s\n", "variant", "isa", "tsc/elem",
+            cycles, instructions, "IPC", branch_misses, l1d_misses);
+
+  for (size_t i = 0; i < variants_count; i++) {
+    const struct bench_variant *v = &variants[i];
+    if (filter != NULL && strstr(v->name, filter) == NULL) continue;
+    struct bench_result thr;
+    bench_measure(v, v->run, out, in, n, reps, warmup, target_ns, &thr);
+
+    double c[PERFCTR_COUNT];
+    perfctr_start(pc);
+    for (long it = 0; it < thr.iters; it++) {
+      v->run(v, out, in, n);
+      bench_escape(out);
+    }
+    perfctr_stop(pc);
+    perfctr_read(pc, c);
+    for (int e = 0; e < PERFCTR_COUNT; e++)
+      if (c[e] >= 0.0) c[e] /= (double)thr.iters * n;
+    double ipc = (c[PERFCTR_CYCLES] > 0.0 && c[PERFCTR_INSTRUCTIONS] >= 0.0)
+      ? c[PERFCTR_INSTRUCTIONS] / c[PERFCTR_CYCLES] : -1.0;
+
+    char f[5][24];
+    const double vals[5] = { c[PERFCTR_CYCLES], c[PERFCTR_INSTRUCTIONS], ipc,
+                             c[PERFCTR_BRANCH_MISSES], c[PERFCTR_L1D_MISSES] };
+    for (int k = 0; k < 5; k++) {
+      if (vals[k] < 0.0)
+        snprintf(f[k], sizeof(f[k]), "%s", (format == BENCH_PERF_CSV) ? "" : "-");
+      else
+        snprintf(f[k], sizeof(f[k]), (k == 3 || k == 4) ? "%.4f" : "%.2f", vals[k]);
+    }
+    if (format == BENCH_PERF_CSV)
+      fprintf(stdout, "%s,%s,%.3f,%s,%s,%s,%s,%s\n", v->name, v->isa, thr.tsc.median,
+              f[0], f[1], f[2], f[3], f[4]);
+    else
+      fprintf(stdout, "%-18s %-9s %9.2f %9s %12s %7s %13s %10s\n", v->name, v->isa,
+              thr.tsc.median, f[0], f[1], f[2], f[3], f[4]);
+    fflush(stdout);
+  }
+}
+
+static int bench_pin(int cpu)
+{
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  return sched_setaffinity(0, sizeof(set), &set);
+}
+
+static void bench_run_parallel(const struct bench_variant *v, float *out, const float *in, size_t n)
+{
+  acos_parallel(v->fn.batch, out, in, n);
+}
+
+/// Scaling table for acos_parallel over acos_nvidia_v: every array size from 64 KiB
+/// (L2-resident) up to max_n elements in steps of 8x, against 1, 2, 4, ... threads up
+/// to max_threads. The inline threshold is disabled so every size goes through the pool.
+/// GB/s counts both the bytes read and the bytes written.
+static int bench_scaling(size_t max_n, int max_threads, int reps, int warmup, double target_ms)
+{
+  float *in = aligned_alloc(64, ((max_n * sizeof(float)) + 63) & ~(size_t)63);
+  float *out = aligned_alloc(64, ((max_n * sizeof(float)) + 63) & ~(size_t)63);
+  if (in == NULL || out == NULL) {
+    fprintf(stderr, "Could not allocate %zu elements.\n", max_n);
+    return -1;
+  }
+  uint32_t seed = 0x12345678u;
+  for (size_t i = 0; i < max_n; i++) {
+    seed = seed * 1664525u + 1013904223u;
+    in[i] = (float)(seed >> 8) * (2.0f / 16777216.0f) - 1.0f;
+  }
+
+  struct bench_variant v = { .name = "acos_nvidia_v", .fn.batch = acos_dispatch->acos_nvidia_v };
+  v.isa = acos_isa_name(acos_dispatch->isa);
+  acos_pool_threshold(0);
+  fprintf(stdout, "# acos_parallel(acos_nvidia_v), dispatch=%s, up to %d threads, reps=%d\n",
+          v.isa, max_threads, reps);
+  fprintf(stdout, "%12s %8s %10s %12s %10s %8s\n",
+          "KiB", "threads", "ns/elem", "Melem/s", "GB/s", "speedup");
+  for (size_t n = 16384; n <= max_n; n *= 8) {
+    double one = 0.0;
+    for (int t = 1; t <= max_threads; t = (t * 2 > max_threads && t < max_threads) ? max_threads : t * 2) {
+      if (acos_pool_init(t) != t) {
+        fprintf(stderr, "Could not start %d threads.\n", t);
+        break;
+      }
+      struct bench_result res;
+      bench_measure(&v, bench_run_parallel, out, in, n, reps, warmup, target_ms * 1e6, &res);
+      double ns = res.ns.median;
+      if (t == 1) one = ns;
+      fprintf(stdout, "%12zu %8d %10.4f %12.1f %10.2f %8.2f\n",
+              n * sizeof(float) / 1024, t, ns, 1e3 / ns, 2.0 * sizeof(float) / ns, one / ns);
+      fflush(stdout);
+    }
+  }
+  acos_pool_shutdown();
+  free(in);
+  free(out);
+  return 0;
+}
+
+static void bench_release(float *in, float *out)
+{
+  free(bench_desa_signal);
+  free(bench_desa_amp);
+  free(bench_double_in);
+  free(bench_double_out);
+  free(bench_f16_in);
+  free(bench_bf16_in);
+  free(bench_q15_in);
+  free(bench_q15_out);
+  free(bench_atan2_x);
+  free(bench_asin_out);
+  free(in);
+  free(out);
+}
+
+static void usage(const char *argv0)
+{
+  fprintf(stderr,
+          "Usage: %s [-m mode] [-n elements] [-r reps] [-w warmup] [-t ms] [-c cpu] [-b rounds] [-f filter]\n"
+          "       [-i lo,hi] [-j threads] [-p table|csv]\n"
+          "  -m  throughput, latency, both, scaling or count (default throughput); count\n"
+          "      runs each variant once over the inputs, untimed and silent, for callgrind,\n"
+          "      with the tiers up to the dispatched one (see ACOS_APPROX_ISA)\n"
+          "  -n  elements per buffer (default 4096; largest size for scaling, default 2^26)\n"
+          "  -r  measured repetitions (default 21)\n"
+          "  -w  warmup repetitions (default 3)\n"
+          "  -t  target duration of one repetition in ms (default 2)\n"
+          "  -c  CPU to pin to (default: the current CPU)\n"
+          "  -b  acos_binomial rounds (default 29)\n"
+          "  -f  only run variants whose name contains this string\n"
+          "  -i  input range (default -1,1); a narrow range models clustered streams\n"
+          "  -j  scaling: largest thread count (default: online CPUs); no pinning\n"
+          "  -p  count cycles, instructions, branch and L1D misses per element with\n"
+          "      perf_event_open over the throughput runner; falls back to timing only\n",
+          argv0);
+}
+
+int main(int argc, char *argv[])
+{
+  enum bench_mode mode = BENCH_THROUGHPUT;
+  size_t n = 0;
+  int threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+  int reps = 21;
+  int warmup = 3;
+  double target_ms = 2.0;
+  int cpu = sched_getcpu();
+  const char *filter = NULL;
+  float lo = -1.0f, hi = 1.0f;
+  enum bench_perf perf = BENCH_PERF_OFF;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "m:n:r:w:t:c:b:f:i:j:p:h")) != -1) {
+    switch (opt) {
+    case 'm':
+      if (strcmp(optarg, "throughput") == 0) mode = BENCH_THROUGHPUT;
+      else if (strcmp(optarg, "latency") == 0) mode = BENCH_LATENCY;
+      else if (strcmp(optarg, "both") == 0) mode = BENCH_BOTH;
+      else if (strcmp(optarg, "scaling") == 0) mode = BENCH_SCALING;
+      else if (strcmp(optarg, "count") == 0) mode = BENCH_COUNT;
+      else { usage(argv[0]); return -1; }
+      break;
+    case 'n': n = strtoul(optarg, NULL, 10); break;
+    case 'r': reps = atoi(optarg); break;
+    case 'w': warmup = atoi(optarg); break;
+    case 't': target_ms = atof(optarg); break;
+    case 'c': cpu = atoi(optarg); break;
+    case 'b': binomial_rounds = atoi(optarg); break;
+    case 'f': filter = optarg; break;
+    case 'j': threads = atoi(optarg); break;
+    case 'p':
+      if (strcmp(optarg, "table") == 0) perf = BENCH_PERF_TABLE;
+      else if (strcmp(optarg, "csv") == 0) perf = BENCH_PERF_CSV;
+      else { usage(argv[0]); return -1; }
+      break;
+    case 'i':
+      if (sscanf(optarg, "%f,%f", &lo, &hi) != 2) { usage(argv[0]); return -1; }
+      break;
+    default: usage(argv[0]); return (opt == 'h') ? 0 : -1;
+    }
+  }
+  if (n == 0) n = (mode == BENCH_SCALING) ? (size_t)1 << 26 : 4096;
+  if (reps < 1 || warmup < 0 || target_ms <= 0.0 || !(lo <= hi) || threads < 1) {
+    usage(argv[0]);
+    return -1;
+  }
+
+  // Not pinned: the pool's workers would inherit the single-CPU mask.
+  if (mode == BENCH_SCALING) return bench_scaling(n, threads, reps, warmup, target_ms);
+
+  if (cpu >= 0 && bench_pin(cpu) != 0) {
+    perror("sched_setaffinity");
+    cpu = -1;
+  }
+
+  float *in = aligned_alloc(64, ((n * sizeof(float)) + 63) & ~(size_t)63);
+  float *out = aligned_alloc(64, ((n * sizeof(float)) + 63) & ~(size_t)63);
+  if (in == NULL || out == NULL) {
+    fprintf(stderr, "Could not allocate %zu elements.\n", n);
+    return -1;
+  }
+  // Deterministic inputs spread over [lo, hi] in a scrambled order so that
+  // data-dependent branches (acos_nvidia0..3) are not trivially predicted.
+  uint32_t seed = 0x12345678u;
+  for (size_t i = 0; i < n; i++) {
+    seed = seed * 1664525u + 1013904223u;
+    in[i] = lo + (float)(seed >> 8) * ((hi - lo) / 16777216.0f);
+  }
+
+  // AM-FM test tone for the DESA variants: carrier near 0.3 rad/sample swept by ±0.1,
+  // amplitude 1 ± 0.3.
+  bench_desa_signal = aligned_alloc(64, ((n * sizeof(float)) + 63) & ~(size_t)63);
+  bench_desa_amp = aligned_alloc(64, ((n * sizeof(float)) + 63) & ~(size_t)63);
+  if (bench_desa_signal == NULL || bench_desa_amp == NULL) {
+    fprintf(stderr, "Could not allocate %zu elements.\n", n);
+    return -1;
+  }
+  for (size_t i = 0; i < n; i++)
+    bench_desa_signal[i] = (float)((1.0 + 0.3 * sin(0.01 * i)) * cos(0.3 * i + 10.0 * sin(0.01 * i)));
+
+  bench_double_in = aligned_alloc(64, ((n * sizeof(double)) + 63) & ~(size_t)63);
+  bench_double_out = aligned_alloc(64, ((n * sizeof(double)) + 63) & ~(size_t)63);
+  bench_f16_in = aligned_alloc(64, ((n * sizeof(uint16_t)) + 63) & ~(size_t)63);
+  bench_bf16_in = aligned_alloc(64, ((n * sizeof(uint16_t)) + 63) & ~(size_t)63);
+  bench_q15_in = aligned_alloc(64, ((n * sizeof(int16_t)) + 63) & ~(size_t)63);
+  bench_q15_out = aligned_alloc(64, ((n * sizeof(int16_t)) + 63) & ~(size_t)63);
+  bench_atan2_x = aligned_alloc(64, ((n * sizeof(float)) + 63) & ~(size_t)63);
+  bench_asin_out = aligned_alloc(64, ((n * sizeof(float)) + 63) & ~(size_t)63);
+  if (bench_double_in == NULL || bench_double_out == NULL || bench_f16_in == NULL ||
+      bench_bf16_in == NULL || bench_q15_in == NULL || bench_q15_out == NULL ||
+      bench_atan2_x == NULL || bench_asin_out == NULL) {
+    fprintf(stderr, "Could not allocate %zu elements.\n", n);
+    return -1;
+  }
+  for (size_t i = 0; i < n; i++) {
+    _Float16 h = (_Float16)in[i];
+    uint32_t bits;
+    memcpy(&bench_f16_in[i], &h, sizeof(h));
+    memcpy(&bits, &in[i], sizeof(bits));
+    bench_bf16_in[i] = (uint16_t)((bits + 0x7fffu + ((bits >> 16) & 1u)) >> 16);
+    bench_double_in[i] = in[i];
+    bench_q15_in[i] = (int16_t)fmaxf(-32768.0f, fminf(32767.0f, rintf(in[i] * 32768.0f)));
+    bench_atan2_x[i] = in[n - 1 - i];
+  }
+
+  // The instruction-count workload (make perfcheck): one untimed run of each variant and
+  // no output, so that callgrind's per-function Ir is the kernels' own cost. The tiers
+  // stop at the dispatched one, so the set of functions does not depend on the host
+  // beyond what ACOS_APPROX_ISA pins.
+  if (mode == BENCH_COUNT) {
+    bench_register(acos_dispatch->isa);
+    for (size_t i = 0; i < variants_count; i++) {
+      const struct bench_variant *v = &variants[i];
+      if (filter != NULL && strstr(v->name, filter) == NULL) continue;
+      v->run(v, out, in, n);
+      bench_escape(out);
+    }
+    bench_release(in, out);
+    return 0;
+  }
+
+  bench_register(acos_isa_detect());
+
+  fprintf(stdout, "# n=%zu reps=%d warmup=%d target=%.1fms cpu=%d dispatch=%s binomial_rounds=%d inputs=[%g, %g]\n",
+          n, reps, warmup, target_ms, cpu, acos_isa_name(acos_dispatch->isa), binomial_rounds, lo, hi);
+
+  if (perf != BENCH_PERF_OFF) {
+    struct perfctr pc;
+    if (perfctr_open(&pc) > 0) {
+      bench_counters(&pc, perf, filter, out, in, n, reps, warmup, target_ms * 1e6);
+      perfctr_close(&pc);
+      bench_release(in, out);
+      return 0;
+    }
+    fprintf(stdout, "# perf counters unavailable (%s); reporting timing only\n",
+            strerror(pc.error));
+  }
+
+  // Latency figures are net of the identity function's chain (call + chaining FMA).
+  struct bench_result base = { 0 };
+  if (mode & BENCH_LATENCY) {
+    struct bench_variant id = { .name = "identity", .isa = "-", .fn.scalar = bench_identity };
+    bench_measure(&id, bench_chain_scalar, out, in, n, reps, warmup, target_ms * 1e6, &base);
+    fprintf(stdout, "# latency is net of the call + chaining overhead: %.2f tsc/call (%.3f ns)\n",
+            base.tsc.median, base.ns.median);
+    fprintf(stdout, "# tsc counts reference cycles at the nominal TSC frequency\n");
+  }
+
+  if (mode == BENCH_THROUGHPUT)
+    fprintf(stdout, "%-18s %-9s %10s %10s %10s %8s %12s %10s\n",
+            "variant", "isa", "ns/elem", "min", "max", "iqr%", "Melem/s", "tsc/elem");
+  else if (mode == BENCH_LATENCY)
+    fprintf(stdout, "%-18s %-9s %10s %10s %10s %8s %10s\n",
+            "variant", "isa", "tsc/call", "min", "max", "iqr%", "ns/call");
+  else
+    fprintf(stdout, "%-18s %-9s %12s %12s\n", "variant", "isa", "thr tsc/call", "lat tsc/call");
+
+  for (size_t i = 0; i < variants_count; i++) {
+    const struct bench_variant *v = &variants[i];
+    struct bench_result thr, lat;
+    if (filter != NULL && strstr(v->name, filter) == NULL) continue;
+    if ((mode & BENCH_THROUGHPUT) != 0)
+      bench_measure(v, v->run, out, in, n, reps, warmup, target_ms * 1e6, &thr);
+    if ((mode & BENCH_LATENCY) != 0) {
+      if (v->chain == NULL) {
+        if (mode == BENCH_LATENCY) continue;
+      } else {
+        bench_measure(v, v->chain, out, in, n, reps, warmup, target_ms * 1e6, &lat);
+      }
+    }
+
+    if (mode == BENCH_THROUGHPUT) {
+      fprintf(stdout, "%-18s %-9s %10.3f %10.3f %10.3f %8.2f %12.1f %10.2f\n",
+              v->name, v->isa, thr.ns.median, thr.ns.min, thr.ns.max,
+              100.0 * thr.ns.iqr / thr.ns.median, 1e3 / thr.ns.median, thr.tsc.median);
+    } else if (mode == BENCH_LATENCY) {
+      fprintf(stdout, "%-18s %-9s %10.2f %10.2f %10.2f %8.2f %10.3f\n",
+              v->name, v->isa, lat.tsc.median - base.tsc.median,
+              lat.tsc.min - base.tsc.median, lat.tsc.max - base.tsc.median,
+              100.0 * lat.tsc.iqr / lat.tsc.median, lat.ns.median - base.ns.median);
+    } else if (v->chain == NULL) {
+      fprintf(stdout, "%-18s %-9s %12.2f %12s\n", v->name, v->isa, thr.tsc.median, "-");
+    } else {
+      // No ratio: throughput includes the call and loop overhead, latency is net of it.
+      fprintf(stdout, "%-18s %-9s %12.2f %12.2f\n",
+              v->name, v->isa, thr.tsc.median, lat.tsc.median - base.tsc.median);
+    }
+    fflush(stdout);
+  }
+
+  bench_release(in, out);
+  return 0;
+}
@@ -0,0 +1,88 @@
+#ifndef __BENCH_H
+#define __BENCH_H
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <sched.h>
+#include <unistd.h>
+#include <math.h>
+#include <x86intrin.h>
+
+#include "acos_dispatch.h"
+#include "acos_nvidia.h"
+#include "acos_nvidia_v.h"
+#include "acos_minimax.h"
+#include "acos_binomial.h"
+#include "desa.h"
+#include "desa_planar.h"
+#include "acos_double.h"
+#include "acos_half.h"
+#include "acos_q15.h"
+#include "asin_atan.h"
+#include "acos_clamp.h"
+#include "acos_parallel.h"
+#include "perfctr.h"
+
+/// One benchmarked function: a tier's build of a kernel, or a libm reference.
+struct bench_variant {
+  char name[32];
+  const char *isa;
+  /// Throughput mode: applies the variant to independent inputs in[0..n) -> out[0..n).
+  void (*run)(const struct bench_variant *v, float *out, const float *in, size_t n);
+  /// Latency mode: feeds each result into the next input, in[i] + out[i-1] * 0.
+  /// NULL for batch kernels, which have no per-call dependency chain.
+  void (*chain)(const struct bench_variant *v, float *out, const float *in, size_t n);
+  union {
+    float (*scalar)(float x);
+    float (*rounds)(float x, int rounds);
+    void (*batch)(float *out, const float *in, size_t n);
+    size_t (*desa)(struct desa_state *s, float *freq, float *amp, const float *in, size_t n);
+    size_t (*desa_planar)(struct desa_state *s, float *const *freq, float *const *amp,
+                          const float *const *in, size_t channels, size_t n);
+    double (*dscalar)(double x);
+    void (*dbatch)(double *out, const double *in, size_t n);
+    void (*half)(float *out, const uint16_t *in, size_t n);
+    int16_t (*qscalar)(int16_t x);
+    void (*qbatch)(int16_t *out, const int16_t *in, size_t n);
+    float (*binary)(float y, float x);
+    void (*batch2)(float *out, const float *y, const float *x, size_t n);
+    float (*fused)(float x, float *asin_x);
+    void (*fbatch)(float *acos_out, float *asin_out, const float *in, size_t n);
+    void (*counted)(float *out, const float *in, size_t n, struct acos_clamp_counts *counts);
+  } fn;
+};
+
+/// Summary of one quantity over the measured repetitions.
+struct bench_stats {
+  double median;
+  double min;
+  double max;
+  double iqr;
+};
+
+/// Per-element cost of one variant in one mode, in ns and in TSC ticks.
+struct bench_result {
+  struct bench_stats ns;
+  struct bench_stats tsc;
+  long iters;  // calibrated runs per repetition
+};
+
+enum bench_mode {
+  BENCH_THROUGHPUT = 1,
+  BENCH_LATENCY = 2,
+  BENCH_BOTH = BENCH_THROUGHPUT | BENCH_LATENCY,
+  BENCH_SCALING = 4,
+  BENCH_COUNT = 8
+};
+
+/// Output of the hardware counter pass (-p).
+enum bench_perf {
+  BENCH_PERF_OFF,
+  BENCH_PERF_TABLE,
+  BENCH_PERF_CSV
+};
+
+#endif
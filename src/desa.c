@@ -0,0 +1,107 @@
+#include "desa.h"
+
+static inline void desa_save(struct desa_state *s, float a, float b, float c, float d)
+{
+  s->x[0] = a; s->x[1] = b; s->x[2] = c; s->x[3] = d;
+}
+
+size_t desa1(struct desa_state *s, float *freq, float *amp, const float *in, size_t n)
+{
+  size_t i = desa_prime(s, in, n);
+  if (i == n) return 0;
+
+  // Window x(k-2) .. x(k+1) around the output sample k, and its backward differences.
+  float a = s->x[0], b = s->x[1], c = s->x[2], d = s->x[3];
+  float yc = c - b, yd = d - c;
+  float psy0 = yc * yc - (b - a) * yd;  // Ψ[y(k)]
+  size_t k = 0;
+  for (; i < n; i++, k++) {
+    float e = in[i];
+    float ye = e - d;
+    float psy1 = yd * yd - yc * ye;  // Ψ[y(k+1)], next iteration's Ψ[y(k)]
+    float psx = c * c - b * d;
+    float g = 1.0f - (psy0 + psy1) / (4.0f * psx);
+    freq[k] = acos_nvidia_ss(g);
+    amp[k] = sqrtf(psx / (1.0f - g * g));
+    a = b; b = c; c = d; d = e;
+    yc = yd; yd = ye;
+    psy0 = psy1;
+  }
+  desa_save(s, a, b, c, d);
+  return k;
+}
+
+size_t desa2(struct desa_state *s, float *freq, float *amp, const float *in, size_t n)
+{
+  size_t i = desa_prime(s, in, n);
+  if (i == n) return 0;
+
+  // Window x(k-2) .. x(k+1); the symmetric differences y(k-1) = x(k) - x(k-2) and
+  // y(k) = x(k+1) - x(k-1) are carried, y(k+1) = x(k+2) - x(k) is formed per sample.
+  float a = s->x[0], b = s->x[1], c = s->x[2], d = s->x[3];
+  float y0 = c - a, y1 = d - b;
+  size_t k = 0;
+  for (; i < n; i++, k++) {
+    float e = in[i];
+    float y2 = e - c;
+    float psy = y1 * y1 - y0 * y2;
+    float psx = c * c - b * d;
+    freq[k] = 0.5f * acos_nvidia_ss(1.0f - psy / (2.0f * psx));
+    amp[k] = 2.0f * psx / sqrtf(psy);
+    a = b; b = c; c = d; d = e;
+    y0 = y1; y1 = y2;
+  }
+  desa_save(s, a, b, c, d);
+  return k;
+}
+
+/// Ψ[x(n)] = x(n)^2 - x(n-1) x(n+1) at w[n].
+static float desa_teager(const float *w, int n)
+{
+  return w[n] * w[n] - w[n - 1] * w[n + 1];
+}
+
+/// Slides the window w = x(k-2) .. x(k+2) by one sample.
+static void desa_push(float *w, float x)
+{
+  memmove(w, w + 1, 4 * sizeof(float));
+  w[4] = x;
+}
+
+size_t desa1_naive(struct desa_state *s, float *freq, float *amp, const float *in, size_t n)
+{
+  size_t i = desa_prime(s, in, n);
+  float w[5];
+  memcpy(w + 1, s->x, sizeof(s->x));
+  size_t k = 0;
+  for (; i < n; i++, k++) {
+    desa_push(w, in[i]);
+    float y[5];
+    for (int j = 1; j < 5; j++) y[j] = w[j] - w[j - 1];
+    float psx = desa_teager(w, 2);
+    float g = 1.0f - (desa_teager(y, 2) + desa_teager(y, 3)) / (4.0f * psx);
+    freq[k] = acosf(g);
+    amp[k] = sqrtf(psx / (1.0f - g * g));
+  }
+  memcpy(s->x, w + 1, sizeof(s->x));
+  return k;
+}
+
+size_t desa2_naive(struct desa_state *s, float *freq, float *amp, const float *in, size_t n)
+{
+  size_t i = desa_prime(s, in, n);
+  float w[5];
+  memcpy(w + 1, s->x, sizeof(s->x));
+  size_t k = 0;
+  for (; i < n; i++, k++) {
+    desa_push(w, in[i]);
+    float y[4];
+    for (int j = 1; j < 4; j++) y[j] = w[j + 1] - w[j - 1];
+    float psx = desa_teager(w, 2);
+    float psy = desa_teager(y, 2);
+    freq[k] = 0.5f * acosf(1.0f - psy / (2.0f * psx));
+    amp[k] = 2.0f * psx / sqrtf(psy);
+  }
+  memcpy(s->x, w + 1, sizeof(s->x));
+  return k;
+}
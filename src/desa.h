@@ -0,0 +1,63 @@
+#ifndef __DESA_H
+#define __DESA_H
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "acos_nvidia_simd.h"
+
+/// Causal state carried between calls to the streaming DESA kernels.
+struct desa_state {
+  float x[4];    // last four samples read, oldest first
+  size_t count;  // samples read so far, saturating at 4
+};
+
+/// Starts a new stream.
+static inline void desa_reset(struct desa_state *s)
+{
+  memset(s, 0, sizeof(*s));
+}
+
+/// Fills the window of a new stream. Returns how many samples of `in` were consumed.
+static inline size_t desa_prime(struct desa_state *s, const float *in, size_t n)
+{
+  size_t i = 0;
+  for (; s->count < 4 && i < n; i++) s->x[s->count++] = in[i];
+  return i;
+}
+
+/// Discrete Energy Separation Algorithm[1] over a sample stream, built on the Teager-Kaiser
+/// energy operator Ψ[x(n)] = x(n)^2 - x(n-1) x(n+1).
+///
+/// DESA-1 uses the backward difference y(n) = x(n) - x(n-1):
+///
+///     G(n) = 1 - (Ψ[y(n)] + Ψ[y(n+1)]) / (4 Ψ[x(n)])
+///     Ω(n) = acos(G(n)),  |a(n)| = sqrt(Ψ[x(n)] / (1 - G(n)^2))
+///
+/// DESA-2 uses the symmetric difference y(n) = x(n+1) - x(n-1):
+///
+///     Ω(n) = acos(1 - Ψ[y(n)] / (2 Ψ[x(n)])) / 2,  |a(n)| = 2 Ψ[x(n)] / sqrt(Ψ[y(n)])
+///
+/// Ω is the instantaneous frequency in radians per sample and |a| the instantaneous
+/// amplitude. Both need x(n-2) .. x(n+2), so the estimate for sample n is written once
+/// sample n + 2 has been read: the first four samples of a stream produce no output and
+/// every later sample produces exactly one. Reads `in[0..n)`, writes the estimates to
+/// `freq` and `amp` and returns how many were written (n, less any samples still priming
+/// the stream). `s` carries the last four samples, so a signal may be fed in any chunking
+/// with identical results.
+///
+/// desa1 and desa2 make one pass over the input with the five-sample window, the
+/// differences and Ψ[y(n+1)] (reused as the next Ψ[y(n)]) held in registers, and inline
+/// acos_nvidia6. There is no clamping: where Ψ[x(n)] <= 0 or the cosine leaves [-1, 1],
+/// the outputs are NaN or inf, exactly as for the direct formulas.
+///
+/// desa1_naive and desa2_naive are the straightforward forms with the same interface: they
+/// slide the window one sample at a time, evaluate each Ψ from the window through a
+/// helper and call libm acosf. They are the reference acos-bench compares against.
+size_t desa1(struct desa_state *s, float *freq, float *amp, const float *in, size_t n);
+size_t desa2(struct desa_state *s, float *freq, float *amp, const float *in, size_t n);
+size_t desa1_naive(struct desa_state *s, float *freq, float *amp, const float *in, size_t n);
+size_t desa2_naive(struct desa_state *s, float *freq, float *amp, const float *in, size_t n);
+
+#endif
@@ -0,0 +1,201 @@
+#include "desa_planar.h"
+
+// One band per lane of the widest vector this tier has, as in acos_minimax.c.
+#if defined(__AVX512F__)
+#define DESA_VBYTES 64
+#elif defined(__AVX__)
+#define DESA_VBYTES 32
+#else
+#define DESA_VBYTES 16
+#endif
+#define DESA_VLANES (DESA_VBYTES / (int)sizeof(float))
+typedef float desa_vf __attribute__((vector_size(DESA_VBYTES)));
+typedef int desa_vi __attribute__((vector_size(DESA_VBYTES)));
+
+static inline desa_vf desa_sqrt_v(desa_vf v)
+{
+#if defined(__AVX512F__)
+  return (desa_vf)_mm512_sqrt_ps((__m512)v);
+#elif defined(__AVX__)
+  return (desa_vf)_mm256_sqrt_ps((__m256)v);
+#else
+  return (desa_vf)_mm_sqrt_ps((__m128)v);
+#endif
+}
+
+/// acos_nvidia_ss over every lane, written with the same expression so the results
+/// match the scalar DESA kernels bit for bit.
+static inline desa_vf desa_acos_v(desa_vf x)
+{
+  const desa_vi sign = (desa_vi){ 0 } + (int)0x80000000;
+  const desa_vi one = (desa_vi)((desa_vf){ 0 } + 1.0f);
+  desa_vf neg = (desa_vf)((x < (desa_vf){ 0 }) & one);
+  desa_vf ax = (desa_vf)((desa_vi)x & ~sign);
+  desa_vf ret = (desa_vf){ 0 } + ACOS_NVIDIA_C3;
+  ret = ret * ax + ACOS_NVIDIA_C2;
+  ret = ret * ax + ACOS_NVIDIA_C1;
+  ret = ret * ax + ACOS_NVIDIA_C0;
+  ret *= desa_sqrt_v(1.0f - ax);
+  return ret + neg * (ACOS_NVIDIA_PI - 2.0f * ret);
+}
+
+/// Transposes a DESA_VLANES x DESA_VLANES tile in registers: on return r[j][l] is what
+/// r[l][j] was.
+static inline __attribute__((always_inline)) void desa_transpose(desa_vf *r)
+{
+#if defined(__AVX512F__)
+  __m512 t[16], u[16];
+  for (int i = 0; i < 16; i += 2) {
+    t[i] = _mm512_unpacklo_ps((__m512)r[i], (__m512)r[i + 1]);
+    t[i + 1] = _mm512_unpackhi_ps((__m512)r[i], (__m512)r[i + 1]);
+  }
+  for (int i = 0; i < 16; i += 4) {
+    u[i] = (__m512)_mm512_unpacklo_pd((__m512d)t[i], (__m512d)t[i + 2]);
+    u[i + 1] = (__m512)_mm512_unpackhi_pd((__m512d)t[i], (__m512d)t[i + 2]);
+    u[i + 2] = (__m512)_mm512_unpacklo_pd((__m512d)t[i + 1], (__m512d)t[i + 3]);
+    u[i + 3] = (__m512)_mm512_unpackhi_pd((__m512d)t[i + 1], (__m512d)t[i + 3]);
+  }
+  // u[4q + k] now holds, in 128-bit lane p, column 4p + k of rows 4q .. 4q + 3.
+  for (int i = 0; i < 16; i += 8) {
+    for (int k = 0; k < 4; k++) {
+      t[i + k] = _mm512_shuffle_f32x4(u[i + k], u[i + 4 + k], 0x88);
+      t[i + 4 + k] = _mm512_shuffle_f32x4(u[i + k], u[i + 4 + k], 0xdd);
+    }
+  }
+  for (int k = 0; k < 8; k++) {
+    r[k] = (desa_vf)_mm512_shuffle_f32x4(t[k], t[8 + k], 0x88);
+    r[8 + k] = (desa_vf)_mm512_shuffle_f32x4(t[k], t[8 + k], 0xdd);
+  }
+#elif defined(__AVX__)
+  __m256 t[8], u[8];
+  for (int i = 0; i < 8; i += 2) {
+    t[i] = _mm256_unpacklo_ps((__m256)r[i], (__m256)r[i + 1]);
+    t[i + 1] = _mm256_unpackhi_ps((__m256)r[i], (__m256)r[i + 1]);
+  }
+  for (int i = 0; i < 8; i += 4) {
+    u[i] = _mm256_shuffle_ps(t[i], t[i + 2], 0x44);
+    u[i + 1] = _mm256_shuffle_ps(t[i], t[i + 2], 0xee);
+    u[i + 2] = _mm256_shuffle_ps(t[i + 1], t[i + 3], 0x44);
+    u[i + 3] = _mm256_shuffle_ps(t[i + 1], t[i + 3], 0xee);
+  }
+  for (int k = 0; k < 4; k++) {
+    r[k] = (desa_vf)_mm256_permute2f128_ps(u[k], u[4 + k], 0x20);
+    r[4 + k] = (desa_vf)_mm256_permute2f128_ps(u[k], u[4 + k], 0x31);
+  }
+#else
+  __m128 r0 = (__m128)r[0], r1 = (__m128)r[1], r2 = (__m128)r[2], r3 = (__m128)r[3];
+  _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+  r[0] = (desa_vf)r0; r[1] = (desa_vf)r1; r[2] = (desa_vf)r2; r[3] = (desa_vf)r3;
+#endif
+}
+
+/// Loads `lanes` bands of `len` samples starting at `off` as the rows of a tile and
+/// transposes it, zero-padding the rest.
+static inline __attribute__((always_inline))
+void desa_load_tile(desa_vf *tile, const float *const *in, size_t off, size_t lanes, size_t len)
+{
+  if (lanes == DESA_VLANES && len == DESA_VLANES) {
+    for (int l = 0; l < DESA_VLANES; l++) memcpy(&tile[l], in[l] + off, sizeof(desa_vf));
+  } else {
+    memset(tile, 0, DESA_VLANES * sizeof(desa_vf));
+    for (size_t l = 0; l < lanes; l++) memcpy(&tile[l], in[l] + off, len * sizeof(float));
+  }
+  desa_transpose(tile);
+}
+
+/// Transposes a tile of time steps back to bands and stores the first `len` samples of
+/// the first `lanes` bands.
+static inline __attribute__((always_inline))
+void desa_store_tile(float *const *out, desa_vf *tile, size_t off, size_t lanes, size_t len)
+{
+  desa_transpose(tile);
+  if (lanes == DESA_VLANES && len == DESA_VLANES) {
+    for (int l = 0; l < DESA_VLANES; l++) memcpy(out[l] + off, &tile[l], sizeof(desa_vf));
+  } else {
+    for (size_t l = 0; l < lanes; l++) memcpy(out[l] + off, &tile[l], len * sizeof(float));
+  }
+}
+
+/// One group of up to DESA_VLANES bands; `variant` is 1 or 2 and folds away.
+static inline __attribute__((always_inline))
+void desa_group(const int variant, struct desa_state *s, float *const *freq, float *const *amp,
+                const float *const *in, size_t lanes, size_t i, size_t n)
+{
+  float w[4][DESA_VLANES] = { { 0 } };
+  for (size_t l = 0; l < lanes; l++)
+    for (int j = 0; j < 4; j++) w[j][l] = s[l].x[j];
+  desa_vf a, b, c, d;
+  memcpy(&a, w[0], sizeof(a)); memcpy(&b, w[1], sizeof(b));
+  memcpy(&c, w[2], sizeof(c)); memcpy(&d, w[3], sizeof(d));
+
+  // Carried differences, as in desa1 (backward) and desa2 (symmetric).
+  desa_vf y0, y1, psy0 = { 0 };
+  if (variant == 1) {
+    y0 = c - b; y1 = d - c;
+    psy0 = y0 * y0 - (b - a) * y1;
+  } else {
+    y0 = c - a; y1 = d - b;
+  }
+
+  for (size_t t = 0; t < n - i; t += DESA_VLANES) {
+    size_t len = (n - i - t < DESA_VLANES) ? n - i - t : DESA_VLANES;
+    desa_vf x[DESA_VLANES], f[DESA_VLANES], m[DESA_VLANES];
+    desa_load_tile(x, in, i + t, lanes, len);
+    for (size_t j = 0; j < len; j++) {
+      desa_vf e = x[j];
+      desa_vf psx = c * c - b * d;
+      if (variant == 1) {
+        desa_vf y2 = e - d;
+        desa_vf psy1 = y1 * y1 - y0 * y2;
+        desa_vf g = 1.0f - (psy0 + psy1) / (4.0f * psx);
+        f[j] = desa_acos_v(g);
+        m[j] = desa_sqrt_v(psx / (1.0f - g * g));
+        y0 = y1; y1 = y2;
+        psy0 = psy1;
+      } else {
+        desa_vf y2 = e - c;
+        desa_vf psy = y1 * y1 - y0 * y2;
+        f[j] = 0.5f * desa_acos_v(1.0f - psy / (2.0f * psx));
+        m[j] = 2.0f * psx / desa_sqrt_v(psy);
+        y0 = y1; y1 = y2;
+      }
+      a = b; b = c; c = d; d = e;
+    }
+    for (size_t j = len; j < DESA_VLANES; j++) f[j] = m[j] = (desa_vf){ 0 };
+    desa_store_tile(freq, f, t, lanes, len);
+    desa_store_tile(amp, m, t, lanes, len);
+  }
+
+  memcpy(w[0], &a, sizeof(a)); memcpy(w[1], &b, sizeof(b));
+  memcpy(w[2], &c, sizeof(c)); memcpy(w[3], &d, sizeof(d));
+  for (size_t l = 0; l < lanes; l++)
+    for (int j = 0; j < 4; j++) s[l].x[j] = w[j][l];
+}
+
+static inline __attribute__((always_inline))
+size_t desa_planar(const int variant, struct desa_state *s, float *const *freq, float *const *amp,
+                   const float *const *in, size_t channels, size_t n)
+{
+  if (channels == 0) return 0;
+  size_t i = 0;
+  for (size_t ch = 0; ch < channels; ch++) i = desa_prime(&s[ch], in[ch], n);
+  if (i == n) return 0;
+
+  for (size_t ch = 0; ch < channels; ch += DESA_VLANES) {
+    size_t lanes = (channels - ch < DESA_VLANES) ? channels - ch : DESA_VLANES;
+    desa_group(variant, s + ch, freq + ch, amp + ch, in + ch, lanes, i, n);
+  }
+  return n - i;
+}
+
+size_t desa1_planar(struct desa_state *s, float *const *freq, float *const *amp,
+                    const float *const *in, size_t channels, size_t n)
+{
+  return desa_planar(1, s, freq, amp, in, channels, n);
+}
+
+size_t desa2_planar(struct desa_state *s, float *const *freq, float *const *amp,
+                    const float *const *in, size_t channels, size_t n)
+{
+  return desa_planar(2, s, freq, amp, in, channels, n);
+}
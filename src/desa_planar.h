@@ -0,0 +1,30 @@
+#ifndef __DESA_PLANAR_H
+#define __DESA_PLANAR_H
+
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <immintrin.h>
+
+#include "desa.h"
+
+/// DESA-1 and DESA-2 (see desa.h) over `channels` independent bands at once.
+///
+/// Band c reads in[c][0..n) and writes freq[c] and amp[c], keeping its own causal state
+/// in s[c]. The layout stays planar for the caller. Internally the bands are taken
+/// 16 (AVX-512), 8 (AVX) or 4 (SSE) at a time, one band per SIMD lane. Each group is
+/// cut into square tiles of lanes x lanes samples, and every tile is transposed in
+/// registers so that one vector holds one time step of every band. The recurrence and
+/// the inlined acos_nvidia6 polynomial then run at full width, and the results are
+/// transposed back before they are stored. A trailing partial group or tile is
+/// zero-padded and its extra lanes are discarded.
+///
+/// Every band gives exactly the output desa1/desa2 would give for it alone, bit for
+/// bit. All bands of one call must be at the same stream position (reset together and
+/// always fed the same n); the return value is the per-band output count.
+size_t desa1_planar(struct desa_state *s, float *const *freq, float *const *amp,
+                    const float *const *in, size_t channels, size_t n);
+size_t desa2_planar(struct desa_state *s, float *const *freq, float *const *amp,
+                    const float *const *in, size_t channels, size_t n);
+
+#endif
@@ -2,8 +2,14 @@
 #define __MAIN_H
 
 #include <stdio.h>
+#include <string.h>
 
 #include "acos_nvidia.h"
+#include "acos_nvidia_v.h"
+#include "acos_minimax.h"
 #include "acos_binomial.h"
+#include "sweep.h"
+#include "stream.h"
+#include "table.h"
 
 #endif
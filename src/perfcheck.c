@@ -0,0 +1,360 @@
+#include "perfcheck.h"
+
+/// Names by callgrind compression id; fn= and cfn= share one id space.
+struct perfcheck_ids {
+  size_t *index;  // id -> index into the set, or SIZE_MAX
+  size_t count;
+};
+
+static void usage(const char *argv0)
+{
+  fprintf(stderr,
+          "Usage: %s [-t percent] [-s] baseline callgrind.out\n"
+          "       %s -w baseline callgrind.out\n"
+          "Compares the self Ir of every function in the baseline with the callgrind\n"
+          "output and fails if one grew by more than the tolerance (default %.1f%%), or\n"
+          "if one was not run at all. With -s, kernels that were not run (a tier the\n"
+          "CPU lacks) are skipped instead. With -w, writes the tiered kernels of the\n"
+          "callgrind output as the baseline.\n",
+          argv0, argv0, PERFCHECK_TOLERANCE);
+}
+
+static char *perfcheck_strdup(const char *s, size_t len)
+{
+  char *d = malloc(len + 1);
+  if (d == NULL) {
+    fprintf(stderr, "Out of memory.\n");
+    exit(-1);
+  }
+  memcpy(d, s, len);
+  d[len] = '\0';
+  return d;
+}
+
+/// Returns the index of `name` in `set`, adding it with no cost if it is new. Loading
+/// is linear in the number of distinct names, which are few next to the cost lines.
+static size_t perfcheck_intern(struct perfcheck_set *set, const char *name, size_t len)
+{
+  for (size_t i = 0; i < set->count; i++)
+    if (strlen(set->fn[i].name) == len && memcmp(set->fn[i].name, name, len) == 0) return i;
+  if (set->count == set->cap) {
+    set->cap = set->cap ? 2 * set->cap : 256;
+    set->fn = realloc(set->fn, set->cap * sizeof(*set->fn));
+    if (set->fn == NULL) {
+      fprintf(stderr, "Out of memory.\n");
+      exit(-1);
+    }
+  }
+  set->fn[set->count] = (struct perfcheck_fn){ perfcheck_strdup(name, len), 0 };
+  return set->count++;
+}
+
+/// Resolves the value of a fn= or cfn= line, "(id) name", "(id)" or "name", to an
+/// index in `set`, recording the name of a new id.
+static size_t perfcheck_name(struct perfcheck_set *set, struct perfcheck_ids *ids, char *s)
+{
+  s[strcspn(s, "\n")] = '\0';
+  if (*s != '(') return perfcheck_intern(set, s, strlen(s));
+
+  char *end;
+  size_t id = strtoul(s + 1, &end, 10);
+  if (*end == ')') end++;
+  while (*end == ' ') end++;
+  if (id >= ids->count) {
+    size_t count = 2 * id + 16;
+    ids->index = realloc(ids->index, count * sizeof(*ids->index));
+    if (ids->index == NULL) {
+      fprintf(stderr, "Out of memory.\n");
+      exit(-1);
+    }
+    for (size_t i = ids->count; i < count; i++) ids->index[i] = SIZE_MAX;
+    ids->count = count;
+  }
+  if (*end != '\0') ids->index[id] = perfcheck_intern(set, end, strlen(end));
+  else if (ids->index[id] == SIZE_MAX) ids->index[id] = perfcheck_intern(set, s, strlen(s));
+  return ids->index[id];
+}
+
+static int perfcheck_cmp(const void *a, const void *b)
+{
+  return strcmp(((const struct perfcheck_fn *)a)->name, ((const struct perfcheck_fn *)b)->name);
+}
+
+static const struct perfcheck_fn *perfcheck_find(const struct perfcheck_set *set, const char *name)
+{
+  struct perfcheck_fn key = { (char *)name, 0 };
+  return bsearch(&key, set->fn, set->count, sizeof(*set->fn), perfcheck_cmp);
+}
+
+#define PERFCHECK_KERNEL_NAME(t, ret, fn, params, args) #fn,
+
+/// Every tiered kernel, unsuffixed.
+static const char *const perfcheck_kernels[] = {
+  ACOS_SCALAR_KERNELS(PERFCHECK_KERNEL_NAME, _)
+  ACOS_BATCH_KERNELS(PERFCHECK_KERNEL_NAME, _)
+  ACOS_DESA_KERNELS(PERFCHECK_KERNEL_NAME, _)
+  ACOS_PRECISION_SCALAR_KERNELS(PERFCHECK_KERNEL_NAME, _)
+  ACOS_PRECISION_BATCH_KERNELS(PERFCHECK_KERNEL_NAME, _)
+  ACOS_TRIG_SCALAR_KERNELS(PERFCHECK_KERNEL_NAME, _)
+  ACOS_TRIG_BATCH_KERNELS(PERFCHECK_KERNEL_NAME, _)
+  ACOS_COUNTED_BATCH_KERNELS(PERFCHECK_KERNEL_NAME, _)
+};
+
+/// True for a tier's build of a kernel, e.g. acos_nvidia6_avx2.
+static int perfcheck_tiered(const char *name)
+{
+  for (size_t k = 0; k < sizeof(perfcheck_kernels) / sizeof(perfcheck_kernels[0]); k++) {
+    size_t n = strlen(perfcheck_kernels[k]);
+    if (strncmp(name, perfcheck_kernels[k], n) != 0 || name[n] != '_') continue;
+    for (int isa = 0; isa < ACOS_ISA_COUNT; isa++)
+      if (strcmp(name + n + 1, acos_isa_kernels(isa)->suffix) == 0) return 1;
+  }
+  return 0;
+}
+
+/// Value of a "key: value" header line, or NULL if `line` is not `key`.
+static char *perfcheck_header(char *line, const char *key)
+{
+  size_t n = strlen(key);
+  if (strncmp(line, key, n) != 0 || line[n] != ':') return NULL;
+  line += n + 1;
+  while (*line == ' ') line++;
+  return perfcheck_strdup(line, strcspn(line, "\n"));
+}
+
+int perfcheck_load_callgrind(const char *path, struct perfcheck_set *set)
+{
+  FILE *f = fopen(path, "r");
+  if (f == NULL) {
+    perror(path);
+    return -1;
+  }
+  memset(set, 0, sizeof(*set));
+  struct perfcheck_ids ids = { NULL, 0 };
+  int positions = 1;  // position columns before the events on a cost line
+  int event = 0;      // column of Ir among the events
+  size_t cur = SIZE_MAX;
+  int calls = 0;      // the next cost line is a call's inclusive cost
+  char *line = NULL;
+  size_t cap = 0;
+  char *v;
+
+  while (getline(&line, &cap, f) > 0) {
+    char c = line[0];
+    if ((c >= '0' && c <= '9') || c == '+' || c == '-' || c == '*') {
+      if (calls) {
+        calls = 0;
+        continue;
+      }
+      if (cur == SIZE_MAX || event < 0) continue;
+      char *p = line;
+      for (int i = 0; i < positions + event && *p != '\0'; i++) {
+        p += strcspn(p, " \n");
+        p += strspn(p, " ");
+      }
+      set->fn[cur].ir += strtoull(p, NULL, 10);
+    } else if (strncmp(line, "fn=", 3) == 0) {
+      cur = perfcheck_name(set, &ids, line + 3);
+    } else if (strncmp(line, "cfn=", 4) == 0) {
+      perfcheck_name(set, &ids, line + 4);
+    } else if (strncmp(line, "calls=", 6) == 0) {
+      calls = 1;
+    } else if ((v = perfcheck_header(line, "positions")) != NULL) {
+      positions = 0;
+      for (char *t = strtok(v, " "); t != NULL; t = strtok(NULL, " ")) positions++;
+      free(v);
+    } else if ((v = perfcheck_header(line, "events")) != NULL) {
+      event = -1;
+      int i = 0;
+      for (char *t = strtok(v, " "); t != NULL; t = strtok(NULL, " "), i++)
+        if (strcmp(t, "Ir") == 0) event = i;
+      free(v);
+    } else if (set->creator == NULL && (v = perfcheck_header(line, "creator")) != NULL) {
+      set->creator = v;
+    } else if (set->cmd == NULL && (v = perfcheck_header(line, "cmd")) != NULL) {
+      set->cmd = v;
+    }
+  }
+  free(line);
+  free(ids.index);
+  fclose(f);
+  if (event < 0) {
+    fprintf(stderr, "%s: no Ir event; record it with valgrind --tool=callgrind.\n", path);
+    return -1;
+  }
+  qsort(set->fn, set->count, sizeof(*set->fn), perfcheck_cmp);
+  return 0;
+}
+
+int perfcheck_load_baseline(const char *path, struct perfcheck_set *set)
+{
+  FILE *f = fopen(path, "r");
+  if (f == NULL) {
+    perror(path);
+    return -1;
+  }
+  memset(set, 0, sizeof(*set));
+  char *line = NULL;
+  size_t cap = 0;
+  int ret = 0;
+  for (int no = 1; getline(&line, &cap, f) > 0; no++) {
+    char *v;
+    if (line[0] == '#') {
+      char *h = line + 1 + strspn(line + 1, " ");
+      if (set->creator == NULL && (v = perfcheck_header(h, "creator")) != NULL) set->creator = v;
+      else if (set->cmd == NULL && (v = perfcheck_header(h, "cmd")) != NULL) set->cmd = v;
+      continue;
+    }
+    if (line[0] == '\n') continue;
+    char *end;
+    uint64_t ir = strtoull(line, &end, 10);
+    end += strspn(end, " \t");
+    size_t len = strcspn(end, " \t\n");
+    if (end == line || len == 0) {
+      fprintf(stderr, "%s:%d: expected \"Ir function\".\n", path, no);
+      ret = -1;
+      break;
+    }
+    size_t i = perfcheck_intern(set, end, len);
+    set->fn[i].ir = ir;
+  }
+  free(line);
+  fclose(f);
+  qsort(set->fn, set->count, sizeof(*set->fn), perfcheck_cmp);
+  return ret;
+}
+
+int perfcheck_write_baseline(const char *path, const struct perfcheck_set *set)
+{
+  FILE *f = fopen(path, "w");
+  if (f == NULL) {
+    perror(path);
+    return -1;
+  }
+  fprintf(f, "# Self Ir per tiered kernel, checked by `make perfcheck`; rewrite it with\n"
+          "# `make perfcheck-baseline` after an intended change or a compiler update.\n");
+  if (set->creator != NULL) fprintf(f, "# creator: %s\n", set->creator);
+  if (set->cmd != NULL) fprintf(f, "# cmd: %s\n", set->cmd);
+  for (size_t i = 0; i < set->count; i++)
+    if (perfcheck_tiered(set->fn[i].name))
+      fprintf(f, "%" PRIu64 " %s\n", set->fn[i].ir, set->fn[i].name);
+  if (fclose(f) != 0) {
+    perror(path);
+    return -1;
+  }
+  return 0;
+}
+
+void perfcheck_free(struct perfcheck_set *set)
+{
+  for (size_t i = 0; i < set->count; i++) free(set->fn[i].name);
+  free(set->fn);
+  free(set->creator);
+  free(set->cmd);
+  memset(set, 0, sizeof(*set));
+}
+
+size_t perfcheck_compare(const struct perfcheck_set *base, const struct perfcheck_set *run,
+                         double tolerance, int allow_missing)
+{
+  size_t regressed = 0, same = 0, skipped = 0;
+  fprintf(stdout, "%-26s %12s %12s %9s\n", "function", "baseline", "current", "change");
+  for (size_t i = 0; i < base->count; i++) {
+    const struct perfcheck_fn *b = &base->fn[i];
+    const struct perfcheck_fn *r = perfcheck_find(run, b->name);
+    if (r == NULL || r->ir == 0) {
+      fprintf(stdout, "%-26s %12" PRIu64 " %12s %9s  %s\n", b->name, b->ir, "-", "-",
+              allow_missing ? "skipped, not run" : "MISSING, not run");
+      skipped++;
+      continue;
+    }
+    if (r->ir == b->ir) {
+      same++;
+      continue;
+    }
+    double change = (b->ir > 0) ? 100.0 * ((double)r->ir - (double)b->ir) / (double)b->ir : 100.0;
+    int bad = change > tolerance;
+    fprintf(stdout, "%-26s %12" PRIu64 " %12" PRIu64 " %+8.2f%%%s\n", b->name, b->ir, r->ir,
+            change, bad ? "  REGRESSED" : "");
+    regressed += bad;
+  }
+  for (size_t i = 0; i < run->count; i++) {
+    const struct perfcheck_fn *r = &run->fn[i];
+    if (r->ir > 0 && perfcheck_tiered(r->name) && perfcheck_find(base, r->name) == NULL)
+      fprintf(stdout, "%-26s %12s %12" PRIu64 " %9s  new, not in baseline\n", r->name, "-", r->ir, "-");
+  }
+  fprintf(stdout, "# %zu functions: %zu unchanged, %zu changed, %zu regressed by more than "
+          "%.1f%%, %zu %s\n", base->count, same, base->count - same - skipped, regressed,
+          tolerance, skipped, allow_missing ? "skipped" : "missing");
+  return regressed + (allow_missing ? 0 : skipped);
+}
+
+/// Length of the tool name in a creator line, without its version ("callgrind-3.18.1").
+static size_t perfcheck_tool(const char *creator)
+{
+  size_t n = 0;
+  while (creator[n] != '\0' && !(creator[n] == '-' && creator[n + 1] >= '0' && creator[n + 1] <= '9'))
+    n++;
+  return n;
+}
+
+/// Counts from two tools need not agree instruction for instruction, so a tolerance
+/// between them means nothing.
+static int perfcheck_same_tool(const struct perfcheck_set *base, const struct perfcheck_set *run)
+{
+  if (base->creator == NULL || run->creator == NULL) return 1;
+  size_t n = perfcheck_tool(base->creator);
+  return n == perfcheck_tool(run->creator) && strncmp(base->creator, run->creator, n) == 0;
+}
+
+int main(int argc, char *argv[])
+{
+  double tolerance = PERFCHECK_TOLERANCE;
+  int write = 0;
+  int allow_missing = 0;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "t:swh")) != -1) {
+    switch (opt) {
+    case 't':
+      if (sscanf(optarg, "%lf", &tolerance) != 1 || !(tolerance >= 0.0)) {
+        usage(argv[0]);
+        return -1;
+      }
+      break;
+    case 's': allow_missing = 1; break;
+    case 'w': write = 1; break;
+    default: usage(argv[0]); return (opt == 'h') ? 0 : -1;
+    }
+  }
+  if (argc - optind != 2) {
+    usage(argv[0]);
+    return -1;
+  }
+
+  struct perfcheck_set run;
+  if (perfcheck_load_callgrind(argv[optind + 1], &run) != 0) return -1;
+  if (write) {
+    int ret = perfcheck_write_baseline(argv[optind], &run);
+    perfcheck_free(&run);
+    return ret;
+  }
+
+  struct perfcheck_set base;
+  if (perfcheck_load_baseline(argv[optind], &base) != 0) {
+    perfcheck_free(&run);
+    return -1;
+  }
+  if (!perfcheck_same_tool(&base, &run)) {
+    fprintf(stderr, "%s was counted by \"%s\", %s by \"%s\"; rewrite the baseline with the "
+            "profiling tool (make perfcheck-baseline).\n", argv[optind], base.creator,
+            argv[optind + 1], run.creator);
+    perfcheck_free(&base);
+    perfcheck_free(&run);
+    return 1;
+  }
+  size_t failed = perfcheck_compare(&base, &run, tolerance, allow_missing);
+  perfcheck_free(&base);
+  perfcheck_free(&run);
+  return failed ? 1 : 0;
+}
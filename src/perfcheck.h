@@ -0,0 +1,56 @@
+#ifndef __PERFCHECK_H
+#define __PERFCHECK_H
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <inttypes.h>
+#include <unistd.h>
+
+#include "acos_dispatch.h"
+
+/// Default allowed growth of a function's Ir over the baseline, in percent.
+#define PERFCHECK_TOLERANCE 2.0
+
+/// Self cost of one function: instructions executed in its own body, not in callees.
+struct perfcheck_fn {
+  char *name;
+  uint64_t ir;
+};
+
+/// Functions of a profile or baseline, sorted by name once loaded.
+struct perfcheck_set {
+  struct perfcheck_fn *fn;
+  size_t count;
+  size_t cap;
+  char *creator;  // tool that produced the counts, from the profile header
+  char *cmd;      // profiled command line
+};
+
+/// Sums the self Ir of every function in a callgrind output file. Name compression,
+/// multiple parts and any `positions:` / `events:` layout are handled; the inclusive
+/// cost lines that follow `calls=` are skipped. Returns 0, or -1 with a message on
+/// stderr.
+int perfcheck_load_callgrind(const char *path, struct perfcheck_set *set);
+
+/// Reads a baseline written by perfcheck_write_baseline. Returns 0 or -1.
+int perfcheck_load_baseline(const char *path, struct perfcheck_set *set);
+
+/// Writes the tiered kernels of `set` (names ending in a tier suffix, e.g.
+/// acos_nvidia6_avx2) as a baseline: '#' header lines, then "Ir name" per line.
+int perfcheck_write_baseline(const char *path, const struct perfcheck_set *set);
+
+void perfcheck_free(struct perfcheck_set *set);
+
+/// Compares `run` with `base` and prints every function whose Ir changed, was not
+/// reached or is new. Returns the number of functions whose Ir grew by more than
+/// `tolerance` percent, plus the baseline functions with no Ir in `run` unless
+/// `allow_missing` is set (a tier the CPU lacks). A renamed kernel, or a profile that
+/// measured nothing, therefore fails.
+size_t perfcheck_compare(const struct perfcheck_set *base, const struct perfcheck_set *run,
+                         double tolerance, int allow_missing);
+
+#endif
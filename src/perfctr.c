@@ -0,0 +1,79 @@
+#include "perfctr.h"
+
+#define PERFCTR_L1D_READ_MISS                                            \
+  (PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |        \
+   (PERF_COUNT_HW_CACHE_RESULT_MISS << 16))
+
+static const struct {
+  const char *name;
+  uint32_t type;
+  uint64_t config;
+} perfctr_events[PERFCTR_COUNT] = {
+  [PERFCTR_CYCLES] = { "cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+  [PERFCTR_INSTRUCTIONS] = { "instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+  [PERFCTR_BRANCH_MISSES] = { "branch-misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+  [PERFCTR_L1D_MISSES] = { "l1d-misses", PERF_TYPE_HW_CACHE, PERFCTR_L1D_READ_MISS },
+};
+
+int perfctr_open(struct perfctr *p)
+{
+  p->open = 0;
+  p->error = 0;
+  for (int e = 0; e < PERFCTR_COUNT; e++) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = perfctr_events[e].type;
+    attr.config = perfctr_events[e].config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    p->fd[e] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    if (p->fd[e] >= 0) {
+      p->open++;
+    } else if (p->error == 0) {
+      p->error = errno;
+    }
+  }
+  return p->open;
+}
+
+void perfctr_close(struct perfctr *p)
+{
+  for (int e = 0; e < PERFCTR_COUNT; e++) {
+    if (p->fd[e] >= 0) close(p->fd[e]);
+    p->fd[e] = -1;
+  }
+  p->open = 0;
+}
+
+void perfctr_start(struct perfctr *p)
+{
+  for (int e = 0; e < PERFCTR_COUNT; e++) {
+    if (p->fd[e] < 0) continue;
+    ioctl(p->fd[e], PERF_EVENT_IOC_RESET, 0);
+    ioctl(p->fd[e], PERF_EVENT_IOC_ENABLE, 0);
+  }
+}
+
+void perfctr_stop(struct perfctr *p)
+{
+  for (int e = 0; e < PERFCTR_COUNT; e++)
+    if (p->fd[e] >= 0) ioctl(p->fd[e], PERF_EVENT_IOC_DISABLE, 0);
+}
+
+void perfctr_read(const struct perfctr *p, double counts[PERFCTR_COUNT])
+{
+  for (int e = 0; e < PERFCTR_COUNT; e++) {
+    uint64_t v[3];  // value, time enabled, time running
+    counts[e] = -1.0;
+    if (p->fd[e] < 0 || read(p->fd[e], v, sizeof(v)) != (ssize_t)sizeof(v) || v[2] == 0) continue;
+    counts[e] = (double)v[0] * ((double)v[1] / (double)v[2]);
+  }
+}
+
+const char *perfctr_name(enum perfctr_event e)
+{
+  return (e < PERFCTR_COUNT) ? perfctr_events[e].name : "unknown";
+}
@@ -0,0 +1,47 @@
+#ifndef __PERFCTR_H
+#define __PERFCTR_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+/// Hardware events acos-bench can report per element.
+enum perfctr_event {
+  PERFCTR_CYCLES,
+  PERFCTR_INSTRUCTIONS,
+  PERFCTR_BRANCH_MISSES,
+  PERFCTR_L1D_MISSES,
+  PERFCTR_COUNT
+};
+
+/// One perf_event_open counter per event, user space only, on the calling thread.
+/// Events the kernel or CPU does not provide (no PMU in a VM, perf_event_paranoid,
+/// no L1D event) are left closed with fd -1 and read back as missing.
+struct perfctr {
+  int fd[PERFCTR_COUNT];
+  int open;           // counters opened
+  int error;          // errno of the first failure, 0 if none
+};
+
+/// Opens every event. Returns the number opened; 0 means counting is unavailable and
+/// p->error says why.
+int perfctr_open(struct perfctr *p);
+void perfctr_close(struct perfctr *p);
+
+/// Resets and enables / disables every open counter.
+void perfctr_start(struct perfctr *p);
+void perfctr_stop(struct perfctr *p);
+
+/// Reads the counts since the last perfctr_start, scaled up if the kernel had to
+/// multiplex the counters. Missing events read as -1.
+void perfctr_read(const struct perfctr *p, double counts[PERFCTR_COUNT]);
+
+/// Short column name of an event, e.g. "cycles".
+const char *perfctr_name(enum perfctr_event e);
+
+#endif
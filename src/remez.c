@@ -0,0 +1,285 @@
+#include "remez.h"
+
+// Dense grid the error is searched on: Chebyshev-Lobatto points on the target interval,
+// which cluster near its ends (for acos, near x = 1 where sqrt(1 - x) squeezes the
+// extrema together).
+#define REMEZ_GRID 200000
+#define REMEZ_TOLERANCE 1e-9L
+// Absolute error spread below which the exchange is only chasing long double rounding
+// (a few ulp of acos near pi/2).
+#define REMEZ_NOISE 1e-18L
+
+static long double grid[REMEZ_GRID];
+
+/// What is being fitted: f(x) ~= p(x) * w(x) on [lo, hi].
+struct remez_target {
+  long double lo, hi;
+  long double (*f)(long double x);
+  long double (*w)(long double x);
+};
+
+static long double remez_acos_w(long double x)
+{
+  return sqrtl(1.0L - x);
+}
+
+/// (asin(s) - s) / s^3 at z = s^2, summed from the Maclaurin series of asin so that
+/// small z loses nothing to cancellation. Converges like z^n, i.e. 4^-n on [0, 1/4].
+static long double remez_asin_f(long double z)
+{
+  long double t = 0.5L;  // (2n)! / (4^n (n!)^2) for n = 1
+  long double zn = 1.0L;
+  long double sum = 0.0L;
+  for (int n = 1; n < 200; n++) {
+    long double term = t / (2 * n + 1) * zn;
+    sum += term;
+    if (term < 1e-24L * sum) break;
+    t *= (2.0L * n + 1.0L) / (2.0L * n + 2.0L);
+    zn *= z;
+  }
+  return sum;
+}
+
+static long double remez_one(long double x)
+{
+  (void)x;
+  return 1.0L;
+}
+
+static const struct remez_target remez_acos = { 0.0L, 1.0L, acosl, remez_acos_w };
+static const struct remez_target remez_asin = { 0.0L, 0.25L, remez_asin_f, remez_one };
+static const struct remez_target *target = &remez_acos;
+
+static long double remez_basis(long double x, int k)
+{
+  return powl(x, k) * target->w(x);
+}
+
+static long double remez_eval(const long double *c, int degree, long double x)
+{
+  long double p = c[degree];
+  for (int k = degree - 1; k >= 0; k--) p = p * x + c[k];
+  return p * target->w(x);
+}
+
+static long double remez_error(const long double *c, int degree, long double x)
+{
+  return remez_eval(c, degree, x) - target->f(x);
+}
+
+/// Solves the (n x n) system a * sol = b in place by Gaussian elimination with
+/// partial pivoting. Returns -1 if the system is singular.
+static int remez_solve(int n, long double a[n][n], long double *b, long double *sol)
+{
+  for (int col = 0; col < n; col++) {
+    int pivot = col;
+    for (int r = col + 1; r < n; r++)
+      if (fabsl(a[r][col]) > fabsl(a[pivot][col])) pivot = r;
+    if (a[pivot][col] == 0.0L) return -1;
+    if (pivot != col) {
+      for (int k = 0; k < n; k++) {
+        long double t = a[col][k]; a[col][k] = a[pivot][k]; a[pivot][k] = t;
+      }
+      long double t = b[col]; b[col] = b[pivot]; b[pivot] = t;
+    }
+    for (int r = col + 1; r < n; r++) {
+      long double m = a[r][col] / a[col][col];
+      for (int k = col; k < n; k++) a[r][k] -= m * a[col][k];
+      b[r] -= m * b[col];
+    }
+  }
+  for (int r = n - 1; r >= 0; r--) {
+    long double s = b[r];
+    for (int k = r + 1; k < n; k++) s -= a[r][k] * sol[k];
+    sol[r] = s / a[r][r];
+  }
+  return 0;
+}
+
+/// Finds degree + 2 alternating extrema of the error on the grid.
+/// Returns the number found, which is less than `need` if the error does not alternate
+/// often enough.
+static int remez_extrema(const long double *c, int degree, long double *ref, int need,
+                         long double *max_err)
+{
+  static long double best_x[REMEZ_GRID];
+  static long double best_e[REMEZ_GRID];
+  int count = 0;
+  *max_err = 0.0L;
+
+  // Largest |error| within each run of equal sign.
+  for (int j = 0; j < REMEZ_GRID; j++) {
+    long double e = remez_error(c, degree, grid[j]);
+    if (fabsl(e) > *max_err) *max_err = fabsl(e);
+    if (e == 0.0L) continue;
+    if (count > 0 && signbit(e) == signbit(best_e[count - 1])) {
+      if (fabsl(e) > fabsl(best_e[count - 1])) {
+        best_x[count - 1] = grid[j];
+        best_e[count - 1] = e;
+      }
+    } else {
+      best_x[count] = grid[j];
+      best_e[count] = e;
+      count++;
+    }
+  }
+
+  // Trim the weaker end until exactly `need` remain; alternation is preserved.
+  int lo = 0, hi = count;
+  while (hi - lo > need) {
+    if (fabsl(best_e[lo]) < fabsl(best_e[hi - 1])) lo++; else hi--;
+  }
+  for (int i = lo; i < hi; i++) ref[i - lo] = best_x[i];
+  return hi - lo;
+}
+
+/// Runs the exchange against `target`.
+static int remez_fit(int degree, struct remez_fit *fit)
+{
+  int n = degree + 2;  // unknowns: c0..c_degree and the level E
+  long double ref[REMEZ_MAX_DEGREE + 2];
+  long double a[n][n];
+  long double b[n];
+  long double sol[n];
+  long double lo = target->lo, span = target->hi - target->lo;
+
+  for (int j = 0; j < REMEZ_GRID; j++)
+    grid[j] = lo + span * (1.0L - cosl(M_PIl * j / (REMEZ_GRID - 1))) / 2.0L;
+  // Initial reference: Chebyshev nodes, kept off the ends (for acos every basis
+  // vanishes at x = 1).
+  for (int i = 0; i < n; i++)
+    ref[i] = lo + span * (1.0L - cosl(M_PIl * (i + 0.5L) / n)) / 2.0L;
+
+  fit->degree = degree;
+  for (int it = 1; it <= REMEZ_MAX_ITERATIONS; it++) {
+    for (int i = 0; i < n; i++) {
+      for (int k = 0; k <= degree; k++) a[i][k] = remez_basis(ref[i], k);
+      a[i][n - 1] = (i & 1) ? -1.0L : 1.0L;
+      b[i] = target->f(ref[i]);
+    }
+    if (remez_solve(n, a, b, sol) != 0) return -1;
+    memcpy(fit->c, sol, (degree + 1) * sizeof(long double));
+    fit->level = fabsl(sol[n - 1]);
+    fit->iterations = it;
+
+    if (remez_extrema(fit->c, degree, ref, n, &fit->max_err) < n) return -1;
+    if (fit->max_err <= fit->level * (1.0L + REMEZ_TOLERANCE) + REMEZ_NOISE) return 0;
+  }
+  return -2;
+}
+
+int remez_fit_acos(int degree, struct remez_fit *fit)
+{
+  target = &remez_acos;
+  return remez_fit(degree, fit);
+}
+
+int remez_fit_asin(int degree, struct remez_fit *fit)
+{
+  target = &remez_asin;
+  return remez_fit(degree, fit);
+}
+
+static void usage(const char *argv0)
+{
+  fprintf(stderr,
+          "Usage: %s lo [hi]\n"
+          "       %s -d degree\n"
+          "Fits acos(x) ~= p(x) * sqrt(1 - x) on [0, 1] for every degree in [lo, hi] and\n"
+          "prints the coefficient tables as a C header (see src/acos_minimax_coeffs.h).\n"
+          "With -d, fits the asin core of acos_double instead and prints it in double\n"
+          "(see src/acos_double_coeffs.h).\n",
+          argv0, argv0);
+}
+
+/// Reports a failed fit; a table that did not converge is never printed.
+static int remez_failed(int rc, int degree)
+{
+  if (rc == -2)
+    fprintf(stderr, "Remez exchange did not converge for degree %d in %d iterations.\n",
+            degree, REMEZ_MAX_ITERATIONS);
+  else
+    fprintf(stderr, "Remez exchange failed for degree %d.\n", degree);
+  return -1;
+}
+
+/// Prints acos_double_coeffs.h for one degree of the asin core.
+static int remez_print_double(int degree)
+{
+  struct remez_fit fit;
+  int rc = remez_fit_asin(degree, &fit);
+  if (rc != 0) return remez_failed(rc, degree);
+  fprintf(stdout,
+          "#ifndef __ACOS_DOUBLE_COEFFS_H\n"
+          "#define __ACOS_DOUBLE_COEFFS_H\n"
+          "\n"
+          "/// Generated by `acos-remez -d %d`; regenerate with `make coeffs` instead of editing.\n"
+          "///\n"
+          "/// asin(s) ~= s + s^3 * (c0 + c1*z + ... + cd*z^d) with z = s^2, s in [0, 1/2], with\n"
+          "/// c0..cd chosen by Remez exchange to minimize the maximum absolute error of the\n"
+          "/// polynomial. ACOS_DOUBLE_C lists c0..cd rounded to double.\n"
+          "/// ACOS_DOUBLE_ERR is the equioscillation level before rounding.\n"
+          "\n"
+          "// degree %d: %d iterations\n"
+          "#define ACOS_DOUBLE_DEGREE %d\n"
+          "#define ACOS_DOUBLE_C",
+          degree, degree, fit.iterations, degree);
+  for (int k = 0; k <= degree; k++)
+    fprintf(stdout, "%s \\\n  %.17e", (k == 0) ? "" : ",", (double)fit.c[k]);
+  fprintf(stdout, "\n#define ACOS_DOUBLE_ERR %.3e\n\n#endif\n", (double)fit.level);
+  return 0;
+}
+
+int main(int argc, char *argv[])
+{
+  int lo, hi;
+  if (argc == 3 && strcmp(argv[1], "-d") == 0) {
+    if (sscanf(argv[2], "%d", &lo) != 1 || lo < 1 || lo > REMEZ_MAX_DEGREE) {
+      usage(argv[0]);
+      return -1;
+    }
+    return remez_print_double(lo);
+  }
+  if (argc < 2 || sscanf(argv[1], "%d", &lo) != 1) {
+    usage(argv[0]);
+    return -1;
+  }
+  hi = lo;
+  if (argc > 2 && sscanf(argv[2], "%d", &hi) != 1) {
+    usage(argv[0]);
+    return -1;
+  }
+  if (lo < 1 || hi < lo || hi > REMEZ_MAX_DEGREE) {
+    fprintf(stderr, "Degrees must satisfy 1 <= lo <= hi <= %d.\n", REMEZ_MAX_DEGREE);
+    return -1;
+  }
+
+  // Every degree is fitted before anything is printed, so a failure leaves no partial
+  // header on stdout.
+  struct remez_fit fits[REMEZ_MAX_DEGREE + 1];
+  for (int d = lo; d <= hi; d++) {
+    int rc = remez_fit_acos(d, &fits[d]);
+    if (rc != 0) return remez_failed(rc, d);
+  }
+
+  fprintf(stdout,
+          "#ifndef __ACOS_MINIMAX_COEFFS_H\n"
+          "#define __ACOS_MINIMAX_COEFFS_H\n"
+          "\n"
+          "/// Generated by `acos-remez %d %d`; regenerate with `make coeffs` instead of editing.\n"
+          "///\n"
+          "/// acos(x) ~= (c0 + c1*x + ... + cd*x^d) * sqrt(1 - x) on [0, 1], with c0..cd chosen\n"
+          "/// by Remez exchange to minimize the maximum absolute error of acos.\n"
+          "/// ACOS_MINIMAX_Cd lists c0..cd rounded to float.\n"
+          "/// ACOS_MINIMAX_ERRd is the equioscillation level before rounding.\n",
+          lo, hi);
+  for (int d = lo; d <= hi; d++) {
+    const struct remez_fit *fit = &fits[d];
+    fprintf(stdout, "\n// degree %d: %d iterations\n#define ACOS_MINIMAX_C%d", d, fit->iterations, d);
+    for (int k = 0; k <= d; k++)
+      fprintf(stdout, "%s %.9ef", (k == 0) ? "" : ",", (double)(float)fit->c[k]);
+    fprintf(stdout, "\n#define ACOS_MINIMAX_ERR%d %.3e\n", d, (double)fit->level);
+  }
+  fprintf(stdout, "\n#endif\n");
+  return 0;
+}
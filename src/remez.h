@@ -0,0 +1,36 @@
+#ifndef __REMEZ_H
+#define __REMEZ_H
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+/// Highest polynomial degree acos-remez will fit.
+#define REMEZ_MAX_DEGREE 24
+
+/// Exchange passes before a fit is reported as not converged.
+#define REMEZ_MAX_ITERATIONS 100
+
+/// Minimax fit of acos(x) ~= p(x) * sqrt(1 - x) on [0, 1], or of the asin core below.
+struct remez_fit {
+  int degree;
+  long double c[REMEZ_MAX_DEGREE + 1];  // c0..c_degree, lowest order first
+  long double level;                    // equioscillation level |E| at convergence
+  long double max_err;                  // max |error| over the dense grid
+  int iterations;
+};
+
+/// Runs Remez exchange for a polynomial of `degree` in long double.
+/// Returns 0 on convergence, -1 if the exchange broke down, or -2 if the error had not
+/// equioscillated after REMEZ_MAX_ITERATIONS passes; `fit` then holds the last pass.
+int remez_fit_acos(int degree, struct remez_fit *fit);
+
+/// Same for the correction term of asin on the reduced range: with z = s^2,
+/// asin(s) ~= s + s^3 * p(z) for s in [0, 1/2], fitted for absolute error in p on
+/// [0, 1/4]. acos_double builds acos from it (see acos_double.h).
+int remez_fit_asin(int degree, struct remez_fit *fit);
+
+#endif
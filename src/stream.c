@@ -0,0 +1,236 @@
+#include "stream.h"
+
+#define STREAM_MAX_KERNELS 64
+
+struct stream_kernel {
+  const char *name;
+  float (*scalar)(float x);
+  void (*batch)(float *out, const float *in, size_t n);
+};
+
+static struct stream_kernel kernels[STREAM_MAX_KERNELS];
+static size_t kernels_count = 0;
+
+static void stream_add_scalar(const char *name, float (*f)(float))
+{
+  if (kernels_count < STREAM_MAX_KERNELS)
+    kernels[kernels_count++] = (struct stream_kernel){ .name = name, .scalar = f };
+}
+
+static void stream_add_rounds(const char *name, float (*f)(float, int))
+{
+  // Kernels with extra parameters have no default to run with here.
+  (void)name;
+  (void)f;
+}
+
+static void stream_add_batch(const char *name, void (*f)(float *, const float *, size_t))
+{
+  if (kernels_count < STREAM_MAX_KERNELS)
+    kernels[kernels_count++] = (struct stream_kernel){ .name = name, .batch = f };
+}
+
+#define STREAM_ADD_KERNEL(k, ret, fn, params, args)                   \
+  _Generic((k)->fn,                                                   \
+           float (*)(float): stream_add_scalar,                       \
+           float (*)(float, int): stream_add_rounds,                  \
+           void (*)(float *, const float *, size_t): stream_add_batch \
+    )(#fn, (k)->fn);
+
+static double stream_now(void)
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+static inline void stream_apply(const struct stream_kernel *k, float *out, const float *in, size_t n)
+{
+  if (k->batch != NULL) {
+    k->batch(out, in, n);
+  } else {
+    for (size_t i = 0; i < n; i++) out[i] = k->scalar(in[i]);
+  }
+}
+
+/// Writes all of buf, retrying short writes. Returns 0 or -1 with errno set.
+static int stream_write(int fd, const void *buf, size_t len)
+{
+  const char *p = buf;
+  while (len > 0) {
+    ssize_t w = write(fd, p, len);
+    if (w < 0) {
+      if (errno == EINTR) continue;
+      return -1;
+    }
+    p += w;
+    len -= (size_t)w;
+  }
+  return 0;
+}
+
+/// Totals for the throughput report.
+struct stream_totals {
+  size_t floats;
+  double kernel_s;
+};
+
+static int stream_chunk(const struct stream_kernel *k, int out_fd, float *out, const float *in,
+                        size_t n, struct stream_totals *t)
+{
+  double t0 = stream_now();
+  stream_apply(k, out, in, n);
+  t->kernel_s += stream_now() - t0;
+  t->floats += n;
+  if (stream_write(out_fd, out, n * sizeof(float)) != 0) {
+    perror("write");
+    return -1;
+  }
+  return 0;
+}
+
+/// Runs the kernel over a mapped regular file. Pages are faulted in as the cursor reaches
+/// them, not up front, so files larger than RAM stream; each chunk asks for the next one
+/// with MADV_WILLNEED so its reads overlap the kernel.
+static int stream_mapped(const struct stream_kernel *k, int in_fd, size_t bytes, int out_fd,
+                         float *out, size_t chunk, struct stream_totals *t)
+{
+  if (bytes < sizeof(float)) return 0;
+  void *map = mmap(NULL, bytes, PROT_READ, MAP_PRIVATE, in_fd, 0);
+  if (map == MAP_FAILED) {
+    perror("mmap");
+    return -1;
+  }
+  madvise(map, bytes, MADV_SEQUENTIAL);
+  const size_t page = (size_t)sysconf(_SC_PAGESIZE);
+  const float *in = map;
+  size_t n = bytes / sizeof(float);
+  int ret = 0;
+  for (size_t i = 0; i < n && ret == 0; i += chunk) {
+    size_t m = (n - i < chunk) ? n - i : chunk;
+    size_t ahead = (i + m) * sizeof(float);
+    if (ahead < bytes) {
+      size_t start = ahead & ~(page - 1);  // madvise needs a page-aligned address
+      size_t len = chunk * sizeof(float) + (ahead - start);
+      madvise((char *)map + start, (len < bytes - start) ? len : bytes - start, MADV_WILLNEED);
+    }
+    ret = stream_chunk(k, out_fd, out, in + i, m, t);
+  }
+  munmap(map, bytes);
+  return ret;
+}
+
+/// Runs the kernel over a pipe or other unmappable input. Reads are accumulated until a
+/// chunk is full, so short reads never split a float.
+static int stream_piped(const struct stream_kernel *k, int in_fd, int out_fd,
+                        float *in, float *out, size_t chunk, size_t *tail, struct stream_totals *t)
+{
+  size_t have = 0;  // bytes buffered in `in`
+  for (;;) {
+    ssize_t r = read(in_fd, (char *)in + have, chunk * sizeof(float) - have);
+    if (r < 0) {
+      if (errno == EINTR) continue;
+      perror("read");
+      return -1;
+    }
+    if (r == 0) break;
+    have += (size_t)r;
+    if (have < chunk * sizeof(float)) continue;  // fill the chunk first
+    if (stream_chunk(k, out_fd, out, in, chunk, t) != 0) return -1;
+    have = 0;
+  }
+  if (have >= sizeof(float) && stream_chunk(k, out_fd, out, in, have / sizeof(float), t) != 0)
+    return -1;
+  *tail = have % sizeof(float);
+  return 0;
+}
+
+int stream_main(int argc, char *argv[])
+{
+  const char *name = "acos_nvidia_v";
+  const char *output = NULL;
+  size_t chunk = STREAM_CHUNK;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "k:c:o:")) != -1) {
+    switch (opt) {
+    case 'k': name = optarg; break;
+    case 'c': chunk = strtoul(optarg, NULL, 10); break;
+    case 'o': output = optarg; break;
+    default:
+      fprintf(stderr, "Usage: %s -s [-k kernel] [-c floats] [-o output] [input]\n", argv[0]);
+      return -1;
+    }
+  }
+  if (chunk == 0 || optind + 1 < argc) {
+    fprintf(stderr, "Usage: %s -s [-k kernel] [-c floats] [-o output] [input]\n", argv[0]);
+    return -1;
+  }
+
+  stream_add_scalar("acosf", acosf);
+  ACOS_SCALAR_KERNELS(STREAM_ADD_KERNEL, acos_dispatch)
+  ACOS_BATCH_KERNELS(STREAM_ADD_KERNEL, acos_dispatch)
+  const struct stream_kernel *k = NULL;
+  for (size_t i = 0; i < kernels_count && k == NULL; i++)
+    if (strcmp(kernels[i].name, name) == 0) k = &kernels[i];
+  if (k == NULL) {
+    fprintf(stderr, "Unknown kernel '%s'. Available:", name);
+    for (size_t i = 0; i < kernels_count; i++) fprintf(stderr, " %s", kernels[i].name);
+    fprintf(stderr, "\n");
+    return -1;
+  }
+
+  const char *input = (optind < argc) ? argv[optind] : "-";
+  int in_fd = (strcmp(input, "-") == 0) ? STDIN_FILENO : open(input, O_RDONLY);
+  if (in_fd < 0) {
+    perror(input);
+    return -1;
+  }
+  int out_fd = STDOUT_FILENO;
+  if (output != NULL && strcmp(output, "-") != 0) {
+    out_fd = open(output, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (out_fd < 0) {
+      perror(output);
+      return -1;
+    }
+  }
+  if (isatty(out_fd)) {
+    fprintf(stderr, "Refusing to write binary output to a terminal; redirect it or use -o.\n");
+    return -1;
+  }
+
+  float *in = aligned_alloc(64, ((chunk * sizeof(float)) + 63) & ~(size_t)63);
+  float *out = aligned_alloc(64, ((chunk * sizeof(float)) + 63) & ~(size_t)63);
+  if (in == NULL || out == NULL) {
+    fprintf(stderr, "Could not allocate %zu-float chunks.\n", chunk);
+    return -1;
+  }
+
+  struct stream_totals t = { 0, 0.0 };
+  struct stat st;
+  size_t tail = 0;
+  int ret;
+  double t0 = stream_now();
+  if (fstat(in_fd, &st) == 0 && S_ISREG(st.st_mode)) {
+    ret = stream_mapped(k, in_fd, (size_t)st.st_size, out_fd, out, chunk, &t);
+    tail = (size_t)st.st_size % sizeof(float);
+  } else {
+    ret = stream_piped(k, in_fd, out_fd, in, out, chunk, &tail, &t);
+  }
+  double total_s = stream_now() - t0;
+
+  if (tail != 0) fprintf(stderr, "Ignored %zu trailing bytes (not a whole float).\n", tail);
+  double gb = t.floats * sizeof(float) * 1e-9;
+  fprintf(stderr, "# %s (%s): %zu floats, %.3f s, %.2f GB/s end to end, %.2f GB/s kernel\n",
+          k->name, acos_isa_name(acos_dispatch->isa), t.floats, total_s,
+          (total_s > 0.0) ? gb / total_s : 0.0, (t.kernel_s > 0.0) ? gb / t.kernel_s : 0.0);
+
+  free(in);
+  free(out);
+  if (in_fd != STDIN_FILENO) close(in_fd);
+  if (out_fd != STDOUT_FILENO && close(out_fd) != 0) {
+    perror(output);
+    ret = -1;
+  }
+  return ret;
+}
@@ -0,0 +1,42 @@
+#ifndef __STREAM_H
+#define __STREAM_H
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <math.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "acos_dispatch.h"
+#include "acos_nvidia.h"
+#include "acos_nvidia_v.h"
+#include "acos_minimax.h"
+#include "acos_lut.h"
+
+/// Floats per chunk by default: 64 KiB of input and 64 KiB of output, which stay in L2
+/// between the kernel and the write.
+#define STREAM_CHUNK (16 * 1024)
+
+/// Applies one kernel to a stream of raw native-endian float32 values and writes the
+/// results as raw float32, with no formatting.
+///
+/// The input is a file named on the command line, or stdin. Regular files (including a
+/// redirected stdin) are memory-mapped and read in place; pipes are read chunk by chunk.
+/// Either way the kernel runs over STREAM_CHUNK floats at a time into one reused output
+/// buffer, which is written to stdout (or -o file) after each chunk. A trailing partial
+/// float is dropped with a warning. Throughput is reported on stderr as GB/s of input,
+/// both end to end and for the kernel alone.
+///
+/// -k selects any dispatched single-argument or batch kernel by name (default
+/// acos_nvidia_v) or libm acosf; scalar kernels are applied element by element.
+///
+/// Usage: acos-approx -s [-k kernel] [-c floats] [-o output] [input]
+int stream_main(int argc, char *argv[]);
+
+#endif
@@ -0,0 +1,355 @@
+#include "sweep.h"
+
+// Inputs are indexed 0..2*SWEEP_HALF: first the bit patterns of +0..+1, then -0..-1.
+// With -a they are every 32-bit pattern instead, NaNs and infinities included.
+#define SWEEP_HALF (0x3F800000u + 1u)
+#define SWEEP_INPUTS (2 * (uint64_t)SWEEP_HALF)
+#define SWEEP_ALL_INPUTS ((uint64_t)1 << 32)
+// Inputs claimed by a thread at a time, and evaluated per pass over the variants.
+#define SWEEP_CHUNK 65536
+#define SWEEP_BLOCK 2048
+#define SWEEP_MAX_VARIANTS 64
+
+struct sweep_variant {
+  const char *name;
+  double (*ref)(double x);  // reference in double precision; acos unless set otherwise
+  float (*scalar)(float x);
+  float (*rounds)(float x, int rounds);
+  void (*batch)(float *out, const float *in, size_t n);
+  float (*binary)(float y, float x);  // atan2 kernels, run as f(1, x)
+  void (*batch2)(float *out, const float *y, const float *x, size_t n);
+};
+
+static struct sweep_variant variants[SWEEP_MAX_VARIANTS];
+static size_t variants_count = 0;
+static int binomial_rounds = 29;
+static int sweep_all = 0;
+static uint64_t sweep_count = SWEEP_INPUTS;
+
+struct sweep_worker {
+  pthread_t thread;
+  uint64_t *next;  // shared chunk counter
+  struct sweep_stats stats[SWEEP_MAX_VARIANTS];
+};
+
+static inline float sweep_input(uint64_t i)
+{
+  uint32_t bits = sweep_all ? (uint32_t)i : (i < SWEEP_HALF) ? (uint32_t)i : 0x80000000u + (uint32_t)(i - SWEEP_HALF);
+  float x;
+  memcpy(&x, &bits, sizeof(x));
+  return x;
+}
+
+/// Maps a float onto the integers so that adjacent floats differ by 1 (-0 == +0).
+static inline int64_t sweep_ordered(float f)
+{
+  int32_t i;
+  memcpy(&i, &f, sizeof(i));
+  return (i < 0) ? -(int64_t)(i & 0x7FFFFFFF) : (int64_t)i;
+}
+
+static inline int sweep_bucket(uint64_t ulp)
+{
+  return (ulp == 0) ? 0 : 64 - __builtin_clzll(ulp);
+}
+
+static void sweep_add_scalar(const char *name, float (*f)(float))
+{
+  variants[variants_count++] = (struct sweep_variant){ .name = name, .ref = acos, .scalar = f };
+}
+
+static void sweep_add_rounds(const char *name, float (*f)(float, int))
+{
+  variants[variants_count++] = (struct sweep_variant){ .name = name, .ref = acos, .rounds = f };
+}
+
+static void sweep_add_batch(const char *name, void (*f)(float *, const float *, size_t))
+{
+  variants[variants_count++] = (struct sweep_variant){ .name = name, .ref = acos, .batch = f };
+}
+
+static void sweep_add_binary(const char *name, float (*f)(float, float))
+{
+  variants[variants_count++] = (struct sweep_variant){ .name = name, .binary = f };
+}
+
+static void sweep_add_batch2(const char *name, void (*f)(float *, const float *, const float *, size_t))
+{
+  variants[variants_count++] = (struct sweep_variant){ .name = name, .batch2 = f };
+}
+
+/// Sets the reference of the variants registered since index `first`.
+static void sweep_set_ref(size_t first, double (*ref)(double))
+{
+  for (size_t v = first; v < variants_count; v++) variants[v].ref = ref;
+}
+
+static double sweep_atan2_1(double x)
+{
+  return atan2(1.0, x);
+}
+
+#define SWEEP_ADD_KERNEL(k, ret, fn, params, args)                   \
+  _Generic((k)->fn,                                                  \
+           float (*)(float): sweep_add_scalar,                       \
+           float (*)(float, int): sweep_add_rounds,                  \
+           void (*)(float *, const float *, size_t): sweep_add_batch \
+    )(#fn, (k)->fn);
+
+static void sweep_update(struct sweep_stats *s, const float *out, const double *ref,
+                         uint64_t base, size_t n)
+{
+  for (size_t i = 0; i < n; i++) {
+    if (isnan(out[i])) {
+      s->nan++;
+      continue;
+    }
+    double abs_err = fabs((double)out[i] - ref[i]);
+    uint64_t ulp = (uint64_t)llabs(sweep_ordered(out[i]) - sweep_ordered((float)ref[i]));
+    s->sum_abs += abs_err;
+    s->hist[sweep_bucket(ulp)]++;
+    if (abs_err > s->max_abs) {
+      s->max_abs = abs_err;
+      s->max_abs_at = base + i;
+    }
+    if (ulp > s->max_ulp) {
+      s->max_ulp = ulp;
+      s->max_ulp_at = base + i;
+    }
+  }
+}
+
+static void *sweep_worker_run(void *arg)
+{
+  struct sweep_worker *w = arg;
+  float x[SWEEP_BLOCK];
+  float ones[SWEEP_BLOCK];
+  float out[SWEEP_BLOCK];
+  double ref[SWEEP_BLOCK];
+  for (size_t i = 0; i < SWEEP_BLOCK; i++) ones[i] = 1.0f;
+
+  for (;;) {
+    uint64_t chunk = __atomic_fetch_add(w->next, 1, __ATOMIC_RELAXED);
+    uint64_t begin = chunk * SWEEP_CHUNK;
+    if (begin >= sweep_count) break;
+    uint64_t end = begin + SWEEP_CHUNK;
+    if (end > sweep_count) end = sweep_count;
+
+    for (uint64_t b = begin; b < end; b += SWEEP_BLOCK) {
+      size_t n = (end - b < SWEEP_BLOCK) ? (size_t)(end - b) : SWEEP_BLOCK;
+      double (*cur)(double) = NULL;  // variants sharing a reference are adjacent
+      for (size_t i = 0; i < n; i++) x[i] = sweep_input(b + i);
+      for (size_t v = 0; v < variants_count; v++) {
+        const struct sweep_variant *sv = &variants[v];
+        if (sv->ref != cur) {
+          cur = sv->ref;
+          for (size_t i = 0; i < n; i++) ref[i] = cur((double)x[i]);
+        }
+        if (sv->batch2 != NULL) {
+          sv->batch2(out, ones, x, n);
+        } else if (sv->binary != NULL) {
+          for (size_t i = 0; i < n; i++) out[i] = sv->binary(1.0f, x[i]);
+        } else if (sv->batch != NULL) {
+          sv->batch(out, x, n);
+        } else if (sv->rounds != NULL) {
+          for (size_t i = 0; i < n; i++) out[i] = sv->rounds(x[i], binomial_rounds);
+        } else {
+          for (size_t i = 0; i < n; i++) out[i] = sv->scalar(x[i]);
+        }
+        sweep_update(&w->stats[v], out, ref, b, n);
+      }
+    }
+  }
+  return NULL;
+}
+
+/// Folds `b` into `a`. Ties on the maxima keep the lower input index so that the
+/// reported argmax does not depend on thread scheduling.
+static void sweep_merge(struct sweep_stats *a, const struct sweep_stats *b)
+{
+  if (b->max_abs > a->max_abs || (b->max_abs == a->max_abs && b->max_abs_at < a->max_abs_at)) {
+    a->max_abs = b->max_abs;
+    a->max_abs_at = b->max_abs_at;
+  }
+  if (b->max_ulp > a->max_ulp || (b->max_ulp == a->max_ulp && b->max_ulp_at < a->max_ulp_at)) {
+    a->max_ulp = b->max_ulp;
+    a->max_ulp_at = b->max_ulp_at;
+  }
+  a->sum_abs += b->sum_abs;
+  a->nan += b->nan;
+  for (int i = 0; i < SWEEP_ULP_BUCKETS; i++) a->hist[i] += b->hist[i];
+}
+
+static void sweep_print(const struct sweep_stats *stats)
+{
+  fprintf(stdout, "%-16s %12s %15s %12s %15s %12s %10s\n",
+          "variant", "max abs err", "at x", "max ulp", "at x", "mean abs", "nan");
+  for (size_t v = 0; v < variants_count; v++) {
+    const struct sweep_stats *s = &stats[v];
+    uint64_t counted = sweep_count - s->nan;
+    fprintf(stdout, "%-16s %12.4e %15.9g %12llu %15.9g %12.4e %10llu\n",
+            variants[v].name, s->max_abs, sweep_input(s->max_abs_at),
+            (unsigned long long)s->max_ulp, sweep_input(s->max_ulp_at),
+            counted ? s->sum_abs / counted : 0.0, (unsigned long long)s->nan);
+  }
+
+  fprintf(stdout, "\n# ulp error histogram: bucket [lo, hi] = share of inputs\n");
+  for (size_t v = 0; v < variants_count; v++) {
+    const struct sweep_stats *s = &stats[v];
+    fprintf(stdout, "%-16s", variants[v].name);
+    for (int b = 0; b < SWEEP_ULP_BUCKETS; b++) {
+      if (s->hist[b] == 0) continue;
+      unsigned long long lo = (b == 0) ? 0 : 1ull << (b - 1);
+      unsigned long long hi = (b == 0) ? 0 : (1ull << b) - 1;
+      fprintf(stdout, " [%llu,%llu]=%.4g%%", lo, hi, 100.0 * s->hist[b] / sweep_count);
+    }
+    fprintf(stdout, "\n");
+  }
+}
+
+/// Q15 comparison (-q): acos_q15_v on every int16 input against the float variants at
+/// the same x = q / 2^15, both as computed and rounded to Q13 like acos_q15's output.
+static void sweep_q15(void)
+{
+  static int16_t q[1 << 16], r[1 << 16];
+  static float x[1 << 16], out[1 << 16];
+  const size_t n = 1 << 16;
+  for (size_t i = 0; i < n; i++) {
+    q[i] = (int16_t)(i - ACOS_Q15_ONE);
+    x[i] = (float)q[i] / ACOS_Q15_ONE;
+  }
+  acos_q15_v(r, q, n);
+
+  fprintf(stdout, "# Q15 grid: %zu inputs in [-1, 1), dispatch=%s, Q13 step %.3e\n", n,
+          acos_isa_name(acos_dispatch->isa), 1.0 / ACOS_Q13_ONE);
+  fprintf(stdout, "%-16s %12s %15s %12s %15s %12s\n",
+          "variant", "max abs err", "at x", "as Q13", "at x", "mean as Q13");
+  for (size_t v = 0; v <= variants_count; v++) {
+    const char *name = "acos_q15_v";
+    if (v < variants_count) {
+      const struct sweep_variant *sv = &variants[v];
+      name = sv->name;
+      if (sv->batch != NULL) {
+        sv->batch(out, x, n);
+      } else {
+        for (size_t i = 0; i < n; i++)
+          out[i] = (sv->rounds != NULL) ? sv->rounds(x[i], binomial_rounds) : sv->scalar(x[i]);
+      }
+    } else {
+      for (size_t i = 0; i < n; i++) out[i] = (float)r[i] / ACOS_Q13_ONE;
+    }
+    double max = 0.0, max13 = 0.0, sum13 = 0.0;
+    size_t at = 0, at13 = 0;
+    for (size_t i = 0; i < n; i++) {
+      double ref = acos((double)x[i]);
+      double e = fabs((double)out[i] - ref);
+      double e13 = fabs(rint((double)out[i] * ACOS_Q13_ONE) / ACOS_Q13_ONE - ref);
+      if (e > max) { max = e; at = i; }
+      if (e13 > max13) { max13 = e13; at13 = i; }
+      sum13 += e13;
+    }
+    fprintf(stdout, "%-16s %12.4e %15.9g %12.4e %15.9g %12.4e\n",
+            name, max, x[at], max13, x[at13], sum13 / n);
+  }
+}
+
+// Variants registered without -a: acosf, every scalar and batch kernel, then asinf,
+// asin_nvidia and asin_nvidia_v. -a registers six.
+#define SWEEP_COUNT_KERNEL(t, ret, fn, params, args) + 1
+_Static_assert(1 + (0 ACOS_SCALAR_KERNELS(SWEEP_COUNT_KERNEL, _)
+                    ACOS_BATCH_KERNELS(SWEEP_COUNT_KERNEL, _)) + 3 <= SWEEP_MAX_VARIANTS,
+               "raise SWEEP_MAX_VARIANTS for the kernel lists");
+
+int sweep_main(int argc, char *argv[])
+{
+  long threads = sysconf(_SC_NPROCESSORS_ONLN);
+  const char *filter = NULL;
+  int q15 = 0;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "j:b:f:qa")) != -1) {
+    switch (opt) {
+    case 'j': threads = atol(optarg); break;
+    case 'b': binomial_rounds = atoi(optarg); break;
+    case 'f': filter = optarg; break;
+    case 'q': q15 = 1; break;
+    case 'a': sweep_all = 1; break;
+    default:
+      fprintf(stderr, "Usage: %s -e [-j threads] [-b rounds] [-f filter] [-q | -a]\n", argv[0]);
+      return -1;
+    }
+  }
+  if (threads < 1) threads = 1;
+
+  if (sweep_all) {
+    sweep_count = SWEEP_ALL_INPUTS;
+    sweep_add_scalar("atanf", atanf);
+    sweep_add_scalar("atan_nvidia", acos_dispatch->atan_nvidia);
+    sweep_add_batch("atan_nvidia_v", acos_dispatch->atan_nvidia_v);
+    sweep_set_ref(0, atan);
+    size_t first = variants_count;
+    sweep_add_binary("atan2f", atan2f);
+    sweep_add_binary("atan2_nvidia", acos_dispatch->atan2_nvidia);
+    sweep_add_batch2("atan2_nvidia_v", acos_dispatch->atan2_nvidia_v);
+    sweep_set_ref(first, sweep_atan2_1);
+  } else {
+    sweep_add_scalar("acosf", acosf);
+    ACOS_SCALAR_KERNELS(SWEEP_ADD_KERNEL, acos_dispatch)
+    ACOS_BATCH_KERNELS(SWEEP_ADD_KERNEL, acos_dispatch)
+    if (!q15) {
+      size_t first = variants_count;
+      sweep_add_scalar("asinf", asinf);
+      sweep_add_scalar("asin_nvidia", acos_dispatch->asin_nvidia);
+      sweep_add_batch("asin_nvidia_v", acos_dispatch->asin_nvidia_v);
+      sweep_set_ref(first, asin);
+    }
+  }
+  if (filter != NULL) {
+    size_t kept = 0;
+    for (size_t v = 0; v < variants_count; v++)
+      if (strstr(variants[v].name, filter) != NULL) variants[kept++] = variants[v];
+    variants_count = kept;
+  }
+  if (q15) {
+    sweep_q15();
+    return 0;
+  }
+
+  struct sweep_worker *workers = calloc(threads, sizeof(*workers));
+  if (workers == NULL) {
+    fprintf(stderr, "Could not allocate %ld workers.\n", threads);
+    return -1;
+  }
+  uint64_t next = 0;
+  struct timespec t0, t1;
+  clock_gettime(CLOCK_MONOTONIC, &t0);
+  for (long t = 0; t < threads; t++) {
+    workers[t].next = &next;
+    if (pthread_create(&workers[t].thread, NULL, sweep_worker_run, &workers[t]) != 0) {
+      // The workers claim chunks from a shared counter, so the ones already running
+      // cover every input on their own.
+      fprintf(stderr, "Could not start worker %ld; sweeping with %ld.\n", t, t);
+      threads = t;
+      break;
+    }
+  }
+  if (threads == 0) {
+    free(workers);
+    return -1;
+  }
+  struct sweep_stats total[SWEEP_MAX_VARIANTS] = { 0 };
+  for (long t = 0; t < threads; t++) {
+    pthread_join(workers[t].thread, NULL);
+    for (size_t v = 0; v < variants_count; v++) sweep_merge(&total[v], &workers[t].stats[v]);
+  }
+  clock_gettime(CLOCK_MONOTONIC, &t1);
+
+  fprintf(stdout, "# exhaustive sweep: %llu inputs %s, %ld threads, dispatch=%s, "
+          "binomial_rounds=%d, %.1f s\n",
+          (unsigned long long)sweep_count,
+          sweep_all ? "(every float; atan2 variants as atan2(1, x))" : "in [-1, 1]", threads, acos_isa_name(acos_dispatch->isa),
+          binomial_rounds, (t1.tv_sec - t0.tv_sec) + 1e-9 * (t1.tv_nsec - t0.tv_nsec));
+  sweep_print(total);
+  free(workers);
+  return 0;
+}
@@ -0,0 +1,43 @@
+#ifndef __SWEEP_H
+#define __SWEEP_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+
+#include "acos_dispatch.h"
+#include "acos_nvidia.h"
+#include "acos_nvidia_v.h"
+#include "acos_minimax.h"
+#include "acos_binomial.h"
+#include "acos_q15.h"
+
+/// ULP histogram buckets: 0, 1, [2, 3], [4, 7], ..., [2^31, 2^32).
+#define SWEEP_ULP_BUCKETS 33
+
+/// Error statistics of one variant over a set of inputs.
+struct sweep_stats {
+  double max_abs;       // max |f(x) - acos(x)| against the double-precision reference
+  uint64_t max_abs_at;  // input index of max_abs (see sweep_input)
+  uint64_t max_ulp;     // max distance in float ULPs from the correctly rounded reference
+  uint64_t max_ulp_at;
+  double sum_abs;
+  uint64_t nan;         // results that were NaN
+  uint64_t hist[SWEEP_ULP_BUCKETS];
+};
+
+/// Checks every variant against `acos` in double precision on every representable float
+/// in [-1, 1] (both zeros included), split across threads; asinf and the asin kernels
+/// are checked against `asin` on the same inputs. With -q, instead compares acos_q15_v
+/// with the acos variants on the 65536 inputs of the Q15 grid. With -a, checks atanf
+/// and the atan kernels against `atan`, and atan2f and the atan2 kernels as
+/// atan2(1, x) against `atan2`, on all 2^32 bit patterns (NaN results counted apart).
+///
+/// Usage: acos-approx -e [-j threads] [-b rounds] [-f filter] [-q | -a]
+int sweep_main(int argc, char *argv[]);
+
+#endif
@@ -0,0 +1,218 @@
+#include "table.h"
+
+/// TSV bytes buffered between writes; a row is at most TABLE_COLUMNS * 48 bytes.
+#define TABLE_TSV_BUFFER (1 << 20)
+
+#define TABLE_VARIANTS 8
+#define TABLE_COLUMNS (2 + 2 * TABLE_VARIANTS)
+
+static int table_rounds;
+
+static float table_binomial(float x)
+{
+  return acos_binomial(x, table_rounds);
+}
+
+static const struct {
+  const char *name;
+  float (*fn)(float);
+} table_variants[TABLE_VARIANTS] = {
+  { "binomial", table_binomial },
+  { "nvidia0", acos_nvidia0 },
+  { "nvidia1", acos_nvidia1 },
+  { "nvidia2", acos_nvidia2 },
+  { "nvidia3", acos_nvidia3 },
+  { "nvidia4", acos_nvidia4 },
+  { "nvidia5", acos_nvidia5 },
+  { "nvidia6", acos_nvidia6 },
+};
+
+/// Writes all of iov[0..n), retrying short writes. Returns 0 or -1 with errno set.
+static int table_writev(int fd, struct iovec *iov, int n)
+{
+  while (n > 0) {
+    ssize_t w = writev(fd, iov, (n < IOV_MAX) ? n : IOV_MAX);
+    if (w < 0) {
+      if (errno == EINTR) continue;
+      return -1;
+    }
+    for (; n > 0 && (size_t)w >= iov->iov_len; iov++, n--) w -= (ssize_t)iov->iov_len;
+    if (n > 0) {
+      iov->iov_base = (char *)iov->iov_base + w;
+      iov->iov_len -= (size_t)w;
+    }
+  }
+  return 0;
+}
+
+static int table_write(int fd, const void *buf, size_t len)
+{
+  struct iovec iov = { (void *)buf, len };
+  return table_writev(fd, &iov, 1);
+}
+
+static int table_binary(int fd, float *const *cols, const char *const *names, size_t rows)
+{
+  struct table_header h = { TABLE_MAGIC, rows, TABLE_COLUMNS, TABLE_NAME_SIZE };
+  char namebuf[TABLE_COLUMNS][TABLE_NAME_SIZE] = { { 0 } };
+  struct iovec iov[2 + TABLE_COLUMNS];
+  for (int c = 0; c < TABLE_COLUMNS; c++) {
+    strncpy(namebuf[c], names[c], TABLE_NAME_SIZE - 1);
+    iov[2 + c] = (struct iovec){ cols[c], rows * sizeof(float) };
+  }
+  iov[0] = (struct iovec){ &h, sizeof(h) };
+  iov[1] = (struct iovec){ namebuf, sizeof(namebuf) };
+  return table_writev(fd, iov, 2 + TABLE_COLUMNS);
+}
+
+// "%f" for floats. v * 10^6 = m * 10^6 * 2^e exactly, with m * 10^6 < 2^44, so the
+// rounding to six decimals is an integer shift with round-half-even, which is what
+// printf does with the exact binary value. Magnitudes of 2^20 and over, infinities and
+// NaN go through snprintf.
+static char *table_format(char *p, float v)
+{
+  float a = fabsf(v);
+  if (!(a < 0x1p20f)) return p + snprintf(p, 48, "%f", v);
+  if (signbit(v)) *p++ = '-';
+
+  int e;
+  uint64_t m = (uint64_t)ldexpf(frexpf(a, &e), 24);  // a = m * 2^(e - 24)
+  uint64_t q = m * 1000000;
+  int shift = 24 - e;
+  if (shift >= 64) {
+    q = 0;
+  } else if (shift > 0) {
+    uint64_t half = (uint64_t)1 << (shift - 1);
+    uint64_t rem = q & ((half << 1) - 1);
+    q >>= shift;
+    if (rem > half || (rem == half && (q & 1))) q++;
+  } else {
+    q <<= -shift;
+  }
+
+  uint64_t ip = q / 1000000;
+  uint32_t fp = (uint32_t)(q % 1000000);
+  char digits[8];
+  int n = 0;
+  do {
+    digits[n++] = (char)('0' + ip % 10);
+    ip /= 10;
+  } while (ip != 0);
+  while (n > 0) *p++ = digits[--n];
+  *p++ = '.';
+  for (int i = 5; i >= 0; i--) {
+    p[i] = (char)('0' + fp % 10);
+    fp /= 10;
+  }
+  return p + 6;
+}
+
+static int table_tsv(int fd, float *const *cols, const char *const *names, size_t rows)
+{
+  char *buf = malloc(TABLE_TSV_BUFFER);
+  if (buf == NULL) return -1;
+  char *p = buf;
+  for (int c = 0; c < TABLE_COLUMNS; c++) {
+    p += strlen(strcpy(p, names[c]));
+    *p++ = (c + 1 < TABLE_COLUMNS) ? '\t' : '\n';
+  }
+  int ret = 0;
+  for (size_t r = 0; r < rows && ret == 0; r++) {
+    for (int c = 0; c < TABLE_COLUMNS; c++) {
+      p = table_format(p, cols[c][r]);
+      *p++ = (c + 1 < TABLE_COLUMNS) ? '\t' : '\n';
+    }
+    if (p - buf > TABLE_TSV_BUFFER - TABLE_COLUMNS * 48) {
+      ret = table_write(fd, buf, (size_t)(p - buf));
+      p = buf;
+    }
+  }
+  if (ret == 0) ret = table_write(fd, buf, (size_t)(p - buf));
+  free(buf);
+  return ret;
+}
+
+int table_main(int argc, char *argv[])
+{
+  const char *output = NULL;
+  int tsv = 0;
+  int opt;
+
+  while ((opt = getopt(argc, argv, "to:")) != -1) {
+    switch (opt) {
+    case 't': tsv = 1; break;
+    case 'o': output = optarg; break;
+    default:
+      fprintf(stderr, "Usage: %s [-t] [-o output] rounds step\n", argv[0]);
+      return -1;
+    }
+  }
+  if (argc - optind < 2) {
+    fprintf(stderr, "Specify approximation rounds and step, -e for the exhaustive sweep\n"
+            "or -s to stream raw float32 data through a kernel.\n");
+    return -1;
+  }
+
+  float step = 0.0f;
+  if (sscanf(argv[optind], "%u", &table_rounds) != 1) {
+    fprintf(stderr, "Invalid rounds specification: %s\n", argv[optind]);
+    return -1;
+  }
+  if (sscanf(argv[optind + 1], "%f", &step) != 1 || !(step > 0.0f)) {
+    fprintf(stderr, "Invalid step specification: %s\n", argv[optind + 1]);
+    return -1;
+  }
+
+  int fd = STDOUT_FILENO;
+  if (output != NULL && strcmp(output, "-") != 0) {
+    fd = open(output, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+      perror(output);
+      return -1;
+    }
+  }
+  if (!tsv && isatty(fd)) {
+    fprintf(stderr, "Refusing to write a binary table to a terminal; redirect it, use -o or -t.\n");
+    return -1;
+  }
+
+  // The grid is accumulated in float exactly as the per-row loop did, so a step that is
+  // not a power of two gives the same drifting x values as before.
+  size_t rows = 0;
+  for (float x = -1.0f; x <= 1.0f; x += step) rows++;
+
+  float *data = malloc(rows * TABLE_COLUMNS * sizeof(float));
+  if (data == NULL) {
+    fprintf(stderr, "Could not allocate a %zu-row table.\n", rows);
+    return -1;
+  }
+  float *cols[TABLE_COLUMNS];
+  char dnames[TABLE_VARIANTS][TABLE_NAME_SIZE];
+  const char *names[TABLE_COLUMNS] = { "x", "acos" };
+  for (int c = 0; c < TABLE_COLUMNS; c++) cols[c] = data + (size_t)c * rows;
+
+  float *xs = cols[0];
+  float *ref = cols[1];
+  float x = -1.0f;
+  for (size_t r = 0; r < rows; r++, x += step) xs[r] = x;
+  for (size_t r = 0; r < rows; r++) ref[r] = acosf(xs[r]);
+  for (int v = 0; v < TABLE_VARIANTS; v++) {
+    float *y = cols[2 + v];
+    float *d = cols[2 + TABLE_VARIANTS + v];
+    float (*f)(float) = table_variants[v].fn;
+    for (size_t r = 0; r < rows; r++) y[r] = f(xs[r]);
+    for (size_t r = 0; r < rows; r++) d[r] = ref[r] - y[r];
+    snprintf(dnames[v], sizeof(dnames[v]), "d_%s", table_variants[v].name);
+    names[2 + v] = table_variants[v].name;
+    names[2 + TABLE_VARIANTS + v] = dnames[v];
+  }
+
+  int ret = tsv ? table_tsv(fd, cols, names, rows) : table_binary(fd, cols, names, rows);
+  if (ret != 0) perror("write");
+  free(data);
+  if (fd != STDOUT_FILENO && close(fd) != 0) {
+    perror(output);
+    ret = -1;
+  }
+  return ret;
+}
@@ -0,0 +1,53 @@
+#ifndef __TABLE_H
+#define __TABLE_H
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <limits.h>
+#include <sys/uio.h>
+
+#include "acos_nvidia.h"
+#include "acos_binomial.h"
+
+/// Identifies a columnar table file; the last byte is the format version.
+#define TABLE_MAGIC "ACOSTAB1"
+
+/// Bytes per column name in the header, NUL-padded.
+#define TABLE_NAME_SIZE 16
+
+/// Header of a columnar table file, followed by `columns` names of TABLE_NAME_SIZE
+/// bytes and then `columns` arrays of `rows` native-endian float32 values, one per
+/// column in the same order. The data starts 4-byte aligned, so with numpy:
+///
+///   h = np.fromfile(f, dtype=np.uint8, count=24)
+///   rows, cols = int(h[8:16].view(np.uint64)[0]), int(h[16:20].view(np.uint32)[0])
+///   data = np.fromfile(f, dtype=np.float32, offset=24 + 16 * cols).reshape(cols, rows)
+struct table_header {
+  char magic[8];
+  uint64_t rows;
+  uint32_t columns;
+  uint32_t name_size;  // TABLE_NAME_SIZE
+};
+
+/// Tabulates acosf, acos_binomial and acos_nvidia0..6, and the error of each against
+/// acosf, for x = -1, -1 + step, ... up to 1 (x accumulated in float, as in the
+/// original harness), all under the column names of plots/acos.out.
+///
+/// Each column is computed over the whole grid into one buffer, so the kernels run back
+/// to back with nothing else in the loop. By default the table is written as a columnar
+/// binary file (struct table_header) with a single writev. A binary table is not
+/// written to a terminal. With -t it is written as TSV instead, with a formatter
+/// whose output is byte-identical to the former "%f" fprintf rows. Either goes to
+/// stdout, or to -o file.
+///
+/// Usage: acos-approx [-t] [-o output] rounds step
+int table_main(int argc, char *argv[]);
+
+#endif